@@ -29,7 +29,9 @@
 #include <pybind11/stl_bind.h>
 
 // C++11 includes
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace py = pybind11;
 
@@ -194,6 +196,7 @@ PYBIND11_MODULE(pyxrt, m) {
         .def(py::init<>())
         .def(py::init<const xrt::kernel &>())
         .def("start", [](xrt::run& r){
+                          py::gil_scoped_release release;
                           r.start();
                       }, "Start one execution of a run")
         .def("set_arg", [](xrt::run& r, int i, xrt::bo& item){
@@ -203,17 +206,28 @@ PYBIND11_MODULE(pyxrt, m) {
                             r.set_arg<int&>(i, item);
                         }, "Set a specific kernel scalar argument for this run")
         .def("wait", ([](xrt::run& r)  {
+                           py::gil_scoped_release release;
                            return r.wait(0);
                       }), "Wait for the run to complete")
         .def("wait", ([](xrt::run& r, unsigned int timeout_ms)  {
+                          py::gil_scoped_release release;
                           return r.wait(timeout_ms);
                       }), "Wait for the specified milliseconds for the run to complete")
         .def("wait2", [](xrt::run&r) { 
+                            py::gil_scoped_release release;
                             return r.wait2();
                     }, "Wait for the run to complete")
         .def("wait2", [](xrt::run&r, const std::chrono::milliseconds& timeout) {
+                            py::gil_scoped_release release;
                             return r.wait2(timeout);
                     }, "Wait for the specified milliseconds for the run to complete")
+        .def("wait_async", [](py::object self, unsigned int timeout_ms) {
+                                // wait() releases the GIL, so it is run in the default
+                                // executor of the running event loop
+                                auto loop = py::module_::import("asyncio").attr("get_running_loop")();
+                                return loop.attr("run_in_executor")(py::none(), self.attr("wait"), timeout_ms);
+                            }, py::arg("timeout_ms") = 0,
+                            "Return an asyncio future which completes with the run state when the run completes")
         .def("state", &xrt::run::state, "Check the current state of a run object")
         .def("add_callback", &xrt::run::add_callback, "Add a callback function for run state");
 
@@ -254,7 +268,10 @@ PYBIND11_MODULE(pyxrt, m) {
                                  i++;
                              }
 
-                             r.start();
+                             {
+                                 py::gil_scoped_release release;
+                                 r.start();
+                             }
                              return r;
                          })
         .def("group_id", &xrt::kernel::group_id, "Get the memory bank group id of an kernel argument");
@@ -280,23 +297,69 @@ PYBIND11_MODULE(pyxrt, m) {
         .def(py::init<xrt::bo, size_t, size_t>(), "Create a sub-buffer of an existing buffer object of specifed size and offset in the existing buffer")
         .def("write", ([](xrt::bo &b, py::buffer pyb, size_t seek)  {
                            py::buffer_info info = pyb.request();
+                           py::gil_scoped_release release;
                            b.write(info.ptr, info.itemsize * info.size , seek);
                        }), "Write the provided data into the buffer object starting at specified offset")
         .def("read", ([](xrt::bo &b, size_t size, size_t skip) {
                           py::array_t<char> result = py::array_t<char>(size);
                           py::buffer_info bufinfo = result.request();
-                          b.read(bufinfo.ptr, size, skip);
+                          {
+                              py::gil_scoped_release release;
+                              b.read(bufinfo.ptr, size, skip);
+                          }
                           return result;
                       }), "Read from the buffer object requested number of bytes starting from specified offset")
+        .def("read_into", ([](xrt::bo &b, py::buffer pyb, size_t skip) {
+                               py::buffer_info info = pyb.request(true);
+                               auto expected = info.itemsize;
+                               for (auto i = info.ndim; i-- > 0;) {
+                                   if (info.shape[i] > 1 && info.strides[i] != expected)
+                                       throw std::invalid_argument("read_into requires a C-contiguous buffer");
+                                   expected *= info.shape[i];
+                               }
+                               auto size = static_cast<size_t>(info.itemsize * info.size);
+                               py::gil_scoped_release release;
+                               b.read(info.ptr, size, skip);
+                           }), py::arg("dst"), py::arg("skip") = 0,
+                           "Read from the buffer object into the provided writable buffer (e.g. ndarray) without allocation")
         .def("sync", ([](xrt::bo &b, xclBOSyncDirection dir, size_t size, size_t offset)  {
+                          py::gil_scoped_release release;
                           b.sync(dir, size, offset);
                       }), "Synchronize (DMA or cache flush/invalidation) the buffer in the requested direction")
         .def("sync", ([](xrt::bo& b, xclBOSyncDirection dir) {
+                          py::gil_scoped_release release;
                           b.sync(dir);
                       }), "Sync entire buffer content in specified direction.")
         .def("map", ([](xrt::bo &b)  {
                          return py::memoryview::from_memory(b.map(), b.size());
                      }), "Create a byte accessible memory view of the buffer object")
+        .def("map", ([](py::object self, const py::object& dtype, const py::object& shape, size_t offset)  {
+                         // The returned array is a view of the mapped buffer, it keeps
+                         // the buffer object alive through its base
+                         auto& b = self.cast<xrt::bo&>();
+                         auto dt = py::dtype::from_args(dtype);
+                         auto itemsize = static_cast<size_t>(dt.itemsize());
+                         if (offset > b.size())
+                             throw std::out_of_range("map offset exceeds buffer size");
+                         std::vector<py::ssize_t> dims;
+                         if (shape.is_none())
+                             dims.push_back(static_cast<py::ssize_t>((b.size() - offset) / itemsize));
+                         else if (py::isinstance<py::int_>(shape))
+                             dims.push_back(shape.cast<py::ssize_t>());
+                         else
+                             dims = shape.cast<std::vector<py::ssize_t>>();
+                         size_t count = 1;
+                         for (auto d : dims) {
+                             if (d < 0)
+                                 throw std::invalid_argument("map shape must be non-negative");
+                             count *= static_cast<size_t>(d);
+                         }
+                         if (count * itemsize > b.size() - offset)
+                             throw std::out_of_range("map shape exceeds buffer size");
+                         auto ptr = static_cast<char*>(b.map()) + offset;
+                         return py::array(dt, dims, ptr, self);
+                     }), py::arg("dtype"), py::arg("shape") = py::none(), py::arg("offset") = 0,
+                     "Create a typed NumPy view of the buffer object with specified dtype and shape")
         .def("size", &xrt::bo::size, "Return the size of the buffer object")
         .def("address", &xrt::bo::address, "Return the device physical address of the buffer object");
 
@@ -487,12 +550,15 @@ PYBIND11_MODULE(pyxrt, m) {
             r.add(run);
         }), "Add a run to the runlist")
         .def("execute", ([](xrt::runlist &r) {
+            py::gil_scoped_release release;
             r.execute();
         }), "Execute all runs in the runlist")
         .def("wait", ([](xrt::runlist &r) {
+            py::gil_scoped_release release;
             r.wait();
         }), "Wait for all runs in the runlist to complete")
         .def("wait", ([](xrt::runlist &r, const std::chrono::milliseconds& timeout) {
+            py::gil_scoped_release release;
             return r.wait(timeout);
         }), "Wait for the specified timeout for the runlist to complete");
         
@@ -4,6 +4,8 @@
 #ifndef xrt_core_command_h_
 #define xrt_core_command_h_
 
+#include "command_trace.h"
+
 #include "core/common/device.h"
 #include "core/common/shim/hwctx_handle.h"
 #include "core/common/shim/buffer_handle.h"
@@ -75,6 +77,16 @@ public:
   virtual hwctx_handle*
   get_hwctx_handle() const = 0;
 
+  // get_trace() - get trace record of current command execution
+  //
+  // Returns nullptr if the command execution is not traced.  The
+  // submission path records its time points in the returned record.
+  virtual command_trace::record*
+  get_trace() const
+  {
+    return nullptr;
+  }
+
 private:
   unsigned long m_uid;
 };
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#include "command_trace.h"
+
+#include "core/common/config_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+// This file uses static globals, which clang-tidy warns about.  We
+// disable the warning for this file.
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+
+namespace {
+
+using xrt_core::command_trace::num_points;
+using xrt_core::command_trace::point;
+using xrt_core::command_trace::record;
+
+// Records per thread
+constexpr size_t ring_size = 1024;
+
+// class ring - Single writer ring buffer of records
+//
+// Each slot is guarded by a sequence number that is odd while the
+// slot is written.  A reader copies the slot and discards the copy if
+// the sequence number changed, which happens only if the writer laps
+// the reader.  All slot members are atomics accessed with relaxed
+// ordering, so concurrent read and write is well defined.
+class ring
+{
+  struct slot
+  {
+    std::atomic<uint64_t> seq {0};
+    std::atomic<uint64_t> uid {0};
+    std::array<std::atomic<uint64_t>, num_points> ns {};
+  };
+
+  std::array<slot, ring_size> m_slots;
+  std::atomic<uint64_t> m_head {0};  // next record to write
+  std::atomic<uint64_t> m_tail {0};  // first record to read
+  uint32_t m_index;                  // index of this ring
+
+public:
+  std::atomic<bool> owned {true};    // ring is owned by a live thread
+
+  explicit
+  ring(uint32_t idx)
+    : m_index(idx)
+  {}
+
+  void
+  push(const record& rec)
+  {
+    auto head = m_head.load(std::memory_order_relaxed);
+    auto& s = m_slots[head % ring_size];
+    s.seq.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.uid.store(rec.uid, std::memory_order_relaxed);
+    for (size_t p = 0; p < num_points; ++p)
+      s.ns[p].store(rec.ns[p], std::memory_order_relaxed);
+    s.seq.store(2 * head + 2, std::memory_order_release);
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  void
+  read(std::vector<record>& records) const
+  {
+    auto head = m_head.load(std::memory_order_acquire);
+    auto tail = std::max(m_tail.load(std::memory_order_relaxed), head > ring_size ? head - ring_size : 0);
+    for (auto idx = tail; idx < head; ++idx) {
+      const auto& s = m_slots[idx % ring_size];
+      auto seq = s.seq.load(std::memory_order_acquire);
+      if (seq != 2 * idx + 2)
+        continue;  // overwritten
+
+      record rec;
+      rec.uid = s.uid.load(std::memory_order_relaxed);
+      rec.thread = m_index;
+      for (size_t p = 0; p < num_points; ++p)
+        rec.ns[p] = s.ns[p].load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s.seq.load(std::memory_order_relaxed) == seq)
+        records.push_back(rec);
+    }
+  }
+
+  void
+  clear()
+  {
+    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+};
+
+// All rings ever created.  A ring is recycled for a new thread when
+// the owning thread exits, so the number of rings is bounded by the
+// maximum number of concurrent committing threads.
+static std::vector<std::shared_ptr<ring>> s_rings;
+static std::mutex s_mutex;
+
+static std::atomic<bool>&
+enabled_flag()
+{
+  static std::atomic<bool> flag {xrt_core::config::get_command_trace()};
+  return flag;
+}
+
+static std::shared_ptr<ring>
+acquire_ring()
+{
+  std::lock_guard lk(s_mutex);
+  for (auto& r : s_rings) {
+    bool owned = false;
+    if (r->owned.compare_exchange_strong(owned, true))
+      return r;
+  }
+
+  return s_rings.emplace_back(std::make_shared<ring>(static_cast<uint32_t>(s_rings.size())));
+}
+
+// Thread local owner of a ring, releases ring for reuse at thread exit
+struct ring_owner
+{
+  std::shared_ptr<ring> r = acquire_ring();
+
+  ~ring_owner()
+  {
+    r->owned = false;
+  }
+
+  ring_owner() = default;
+  ring_owner(const ring_owner&) = delete;
+  ring_owner(ring_owner&&) = delete;
+  ring_owner& operator=(const ring_owner&) = delete;
+  ring_owner& operator=(ring_owner&&) = delete;
+};
+
+static ring&
+get_thread_ring()
+{
+  thread_local ring_owner owner;
+  return *owner.r;
+}
+
+// Stages reported by summary(), each is time between two points
+struct stage
+{
+  const char* name;
+  point from;
+  point to;
+};
+
+constexpr std::array<stage, 6> stages {{
+  {"encode", point::encode, point::start},
+  {"prepare", point::start, point::submit},
+  {"submit", point::submit, point::submitted},
+  {"execute", point::submitted, point::complete},
+  {"notify", point::complete, point::notify},
+  {"total", point::start, point::notify},
+}};
+
+static double
+percentile(const std::vector<uint64_t>& sorted, double pct)
+{
+  auto idx = static_cast<size_t>(pct / 100.0 * (sorted.size() - 1) + 0.5);
+  return static_cast<double>(sorted[std::min(idx, sorted.size() - 1)]) / 1000.0;
+}
+
+} // namespace
+
+namespace xrt_core::command_trace {
+
+bool
+enabled()
+{
+  return enabled_flag().load(std::memory_order_relaxed);
+}
+
+void
+enable(bool value)
+{
+  enabled_flag() = value;
+}
+
+void
+commit(const record& rec)
+{
+  get_thread_ring().push(rec);
+}
+
+std::vector<record>
+get_records()
+{
+  std::vector<record> records;
+  {
+    std::lock_guard lk(s_mutex);
+    for (const auto& r : s_rings)
+      r->read(records);
+  }
+
+  std::sort(records.begin(), records.end(), [](const auto& r1, const auto& r2) {
+    return r1.get(point::start) < r2.get(point::start);
+  });
+  return records;
+}
+
+void
+clear()
+{
+  std::lock_guard lk(s_mutex);
+  for (auto& r : s_rings)
+    r->clear();
+}
+
+std::string
+summary(const std::vector<record>& records)
+{
+  std::ostringstream os;
+  os << std::left << std::setw(9) << "stage" << std::right << std::setw(8) << "count"
+     << std::setw(10) << "p50(us)" << std::setw(10) << "p90(us)"
+     << std::setw(10) << "p99(us)" << std::setw(10) << "max(us)" << '\n';
+
+  std::vector<uint64_t> samples;
+  samples.reserve(records.size());
+  for (const auto& st : stages) {
+    samples.clear();
+    for (const auto& rec : records)
+      if (rec.get(st.from) && rec.get(st.to))
+        samples.push_back(rec.elapsed(st.from, st.to));
+
+    os << std::left << std::setw(9) << st.name << std::right << std::setw(8) << samples.size();
+    if (samples.empty()) {
+      os << '\n';
+      continue;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    os << std::fixed << std::setprecision(2)
+       << std::setw(10) << percentile(samples, 50) << std::setw(10) << percentile(samples, 90)
+       << std::setw(10) << percentile(samples, 99) << std::setw(10) << percentile(samples, 100)
+       << '\n';
+  }
+  return os.str();
+}
+
+std::string
+to_csv(const std::vector<record>& records)
+{
+  std::ostringstream os;
+  os << "uid,thread,encode_ns,start_ns,submit_ns,submitted_ns,complete_ns,notify_ns\n";
+  for (const auto& rec : records) {
+    os << rec.uid << ',' << rec.thread;
+    for (auto ns : rec.ns)
+      os << ',' << ns;
+    os << '\n';
+  }
+  return os.str();
+}
+
+} // xrt_core::command_trace
+
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
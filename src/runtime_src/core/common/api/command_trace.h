@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrt_core_command_trace_h_
+#define xrt_core_command_trace_h_
+
+#include "core/common/config.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Light weight host side latency trace of command execution
+//
+// When enabled (xrt.ini Runtime.command_trace=true), each execution
+// of a kernel command records time points of its lifecycle from
+// argument encoding to completion notification.  Completed records
+// are committed to a fixed size ring buffer owned by the committing
+// thread, so recording involves no locks and no allocation.  The
+// rings can be read at any time through get_records().
+//
+// This is independent of XDP and is meant to attribute host overhead
+// of command execution in production builds.
+namespace xrt_core::command_trace {
+
+// Time points of one command execution, in execution order
+enum class point : uint8_t
+{
+  encode,     // first argument set after previous execution
+  start,      // run start, before command packet is prepared
+  submit,     // command handed to hw queue for submission
+  submitted,  // hw queue submission returned
+  complete,   // host observed command completion
+  notify,     // waiters and callbacks notified of completion
+};
+
+constexpr size_t num_points = static_cast<size_t>(point::notify) + 1;
+
+// struct record - Time points of one command execution
+//
+// @uid:     unique id of the command object
+// @thread:  index of ring buffer (thread) the record was committed to
+// @ns:      steady clock time in ns of each point, 0 if not recorded
+struct record
+{
+  uint64_t uid = 0;
+  uint32_t thread = 0;
+  std::array<uint64_t, num_points> ns {};
+
+  static uint64_t
+  now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  void
+  stamp(point p)
+  {
+    ns[static_cast<size_t>(p)] = now();
+  }
+
+  // Record point unless already recorded
+  void
+  stamp_once(point p)
+  {
+    if (!ns[static_cast<size_t>(p)])
+      stamp(p);
+  }
+
+  uint64_t
+  get(point p) const
+  {
+    return ns[static_cast<size_t>(p)];
+  }
+
+  // Time between two points, 0 if either point is not recorded
+  uint64_t
+  elapsed(point from, point to) const
+  {
+    return (get(from) && get(to) >= get(from)) ? get(to) - get(from) : 0;
+  }
+
+  void
+  reset()
+  {
+    ns.fill(0);
+  }
+};
+
+// enabled() - Check if command tracing is enabled
+//
+// Initialized from xrt.ini Runtime.command_trace
+XRT_CORE_COMMON_EXPORT
+bool
+enabled();
+
+// enable() - Enable or disable command tracing at runtime
+//
+// Commands already executing when tracing is enabled are not traced.
+XRT_CORE_COMMON_EXPORT
+void
+enable(bool value);
+
+// commit() - Commit a completed record to calling thread's ring buffer
+//
+// The oldest record of the ring is overwritten when the ring is full.
+XRT_CORE_COMMON_EXPORT
+void
+commit(const record& rec);
+
+// get_records() - Get all records currently in the ring buffers
+//
+// Records are sorted by start time.  The function can be called
+// while commands are executing, records that are overwritten while
+// being read are skipped.
+XRT_CORE_COMMON_EXPORT
+std::vector<record>
+get_records();
+
+// clear() - Discard records currently in the ring buffers
+XRT_CORE_COMMON_EXPORT
+void
+clear();
+
+// summary() - Latency percentiles of each stage between two points
+//
+// Returns a human readable table with one row per stage
+XRT_CORE_COMMON_EXPORT
+std::string
+summary(const std::vector<record>& records);
+
+// to_csv() - Format records as csv with one row per record
+XRT_CORE_COMMON_EXPORT
+std::string
+to_csv(const std::vector<record>& records);
+
+} // xrt_core::command_trace
+
+#endif
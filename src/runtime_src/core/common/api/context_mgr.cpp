@@ -27,6 +27,12 @@ namespace xrt_core::context_mgr {
 // The synchronization ensures that when a thread is in the process of
 // releasing a context, another thread wont call xclOpenContext before
 // the former has closed its context.
+//
+// The shim open and close calls are made outside the manager lock so
+// that contexts on different IPs can be opened and closed
+// concurrently.  An IP is reserved by name while its context is being
+// opened and stays recorded while its context is being closed, which
+// keeps other threads from operating on the same IP.
 class device_context_mgr : public xrt_core::device::context_mgr
 {
   // CU indeces are managed per hwctx
@@ -52,13 +58,29 @@ class device_context_mgr : public xrt_core::device::context_mgr
     const ip*
     get(const std::string& ipname)
     {
-      return m_nm2ip[ipname].get();
+      auto itr = m_nm2ip.find(ipname);
+      return itr != m_nm2ip.end() ? (*itr).second.get() : nullptr;
     }
 
     const ip*
     get(cuidx_type ipidx)
     {
-      return m_idx2ip[ipidx.index].get();
+      auto itr = m_idx2ip.find(ipidx.index);
+      return itr != m_idx2ip.end() ? (*itr).second.get() : nullptr;
+    }
+
+    // Reserve ipname while its context is being opened
+    void
+    reserve(const std::string& ipname)
+    {
+      m_nm2ip[ipname] = std::make_shared<ip>(ipname, cuidx_type{});
+    }
+
+    // Release reservation of ipname if open failed
+    void
+    release(const std::string& ipname)
+    {
+      m_nm2ip.erase(ipname);
     }
 
     void
@@ -91,13 +113,27 @@ public:
   {
     std::unique_lock<std::mutex> ul(m_mutex);
     auto hwctx_hdl = static_cast<hwctx_handle*>(hwctx);
-    auto& ctx = m_ctx[hwctx_hdl];
+    auto& ctx = m_ctx[hwctx_hdl]; // stable, m_ctx entries are never erased
     while (ctx.get(ipname)) {
       if (m_cv.wait_for(ul, 100ms) == std::cv_status::timeout) // NOLINT
         throw std::runtime_error("aquiring cu context timed out");
     }
 
-    auto ipidx = hwctx_hdl->open_cu_context(ipname);
+    ctx.reserve(ipname);
+    ul.unlock();
+
+    cuidx_type ipidx;
+    try {
+      ipidx = hwctx_hdl->open_cu_context(ipname);
+    }
+    catch (...) {
+      ul.lock();
+      ctx.release(ipname);
+      m_cv.notify_all();
+      throw;
+    }
+
+    ul.lock();
     ctx.add(ipname, ipidx);
     return ipidx;
   }
@@ -107,13 +143,16 @@ public:
   void
   close(const xrt::hw_context& hwctx, cuidx_type ipidx)
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
+    std::unique_lock<std::mutex> ul(m_mutex);
     auto hwctx_hdl = static_cast<hwctx_handle*>(hwctx);
     auto& ctx = m_ctx[hwctx_hdl];
     if (!ctx.get(ipidx))
       throw std::runtime_error("ctx " + std::to_string(ipidx.index) + " not open");
 
+    // The ip remains recorded while closing, open of same ip waits
+    ul.unlock();
     hwctx_hdl->close_cu_context(ipidx);
+    ul.lock();
     ctx.erase(ipidx);
     m_cv.notify_all();
   }
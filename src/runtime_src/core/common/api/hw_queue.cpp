@@ -27,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -59,6 +60,14 @@ completed(xrt_core::command* cmd)
   return (get_command_state(cmd) >= ERT_CMD_STATE_COMPLETED);
 }
 
+// Record time point of command execution if command is traced
+inline void
+trace(xrt_core::command* cmd, xrt_core::command_trace::point p)
+{
+  if (auto rec = cmd->get_trace())
+    rec->stamp(p);
+}
+
 inline void
 notify_host(xrt_core::command* cmd, ert_cmd_state state)
 {
@@ -268,7 +277,9 @@ public:
 
     // Submit the command
     try {
+      trace(cmd, xrt_core::command_trace::point::submit);
       m_impl->submit(cmd);
+      trace(cmd, xrt_core::command_trace::point::submitted);
     }
     catch (...) {
       // Remove the pending command
@@ -386,6 +397,10 @@ public:
   virtual void
   submit(xrt_core::command* cmd) = 0;  // NOLINT override from base
 
+  // Submit independent commands for execution
+  virtual void
+  submit(const std::vector<xrt_core::command*>& cmds) = 0;
+
   // Wait for some command to finish
   virtual std::cv_status
   wait(size_t timeout_ms) = 0;         // NOLINT override from base
@@ -423,7 +438,20 @@ public:
   void
   unmanaged_start(xrt_core::command* cmd)
   {
+    trace(cmd, xrt_core::command_trace::point::submit);
     submit(cmd);
+    trace(cmd, xrt_core::command_trace::point::submitted);
+  }
+
+  // Unmanaged start of independent commands with one submission
+  void
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+  {
+    for (auto cmd : cmds)
+      trace(cmd, xrt_core::command_trace::point::submit);
+    submit(cmds);
+    for (auto cmd : cmds)
+      trace(cmd, xrt_core::command_trace::point::submitted);
   }
 
 };
@@ -490,6 +518,16 @@ public:
     m_qhdl->submit_command(cmd->get_exec_bo());
   }
 
+  void
+  submit(const std::vector<xrt_core::command*>& cmds) override
+  {
+    std::vector<xrt_core::buffer_handle*> bos;
+    bos.reserve(cmds.size());
+    for (auto cmd : cmds)
+      bos.push_back(cmd->get_exec_bo());
+    m_qhdl->submit_commands(bos);
+  }
+
   void
   submit(xrt_core::buffer_handle* cmd) override
   {
@@ -698,6 +736,28 @@ public:
     m_device->exec_buf(cmd->get_exec_bo());
   }
 
+  // Commands of a batch share the hw context of the first command,
+  // commands without a context are submitted one at a time
+  void
+  submit(const std::vector<xrt_core::command*>& cmds) override
+  {
+    if (cmds.empty())
+      return;
+
+    auto hwctx = cmds.front()->get_hwctx_handle();
+    if (!hwctx) {
+      for (auto cmd : cmds)
+        submit(cmd);
+      return;
+    }
+
+    std::vector<xrt_core::buffer_handle*> bos;
+    bos.reserve(cmds.size());
+    for (auto cmd : cmds)
+      bos.push_back(cmd->get_exec_bo());
+    hwctx->exec_bufs(bos);
+  }
+
   void
   submit(xrt_core::buffer_handle* cmd) override
   {
@@ -902,6 +962,13 @@ unmanaged_start(xrt_core::command* cmd)
   get_handle()->unmanaged_start(cmd);
 }
 
+void
+hw_queue::
+unmanaged_start(const std::vector<xrt_core::command*>& cmds)
+{
+  get_handle()->unmanaged_start(cmds);
+}
+
 void
 hw_queue::
 submit(xrt_core::buffer_handle* cmd)
@@ -53,6 +53,12 @@ public:
   void
   unmanaged_start(xrt_core::command* cmd);
 
+  // Start independent commands with one call to the shim, which
+  // currently submits them to the driver one at a time.  Completion of each command is controlled by the
+  // application as with unmanaged_start().
+  void
+  unmanaged_start(const std::vector<xrt_core::command*>& cmds);
+
   // Submit a raw cmd for execution
   void
   submit(xrt_core::buffer_handle* cmd);
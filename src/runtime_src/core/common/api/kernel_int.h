@@ -11,6 +11,8 @@
 #include "core/include/xrt/experimental/xrt_kernel.h"
 #include "core/include/xrt/experimental/xrt_xclbin.h"
 
+#include "command_trace.h"
+
 #include "core/common/config.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/shim/buffer_handle.h"
@@ -79,6 +81,12 @@ XRT_CORE_COMMON_EXPORT
 void
 pop_callback(const xrt::run& run);
 
+// Time points of most recently completed execution of the run
+// object when command tracing is enabled, see command_trace.h
+XRT_CORE_COMMON_EXPORT
+xrt_core::command_trace::record
+get_command_trace(const xrt::run& run);
+
 XRT_CORE_COMMON_EXPORT
 size_t
 get_regmap_size(const xrt::kernel& kernel);
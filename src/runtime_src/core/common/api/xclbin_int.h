@@ -24,6 +24,13 @@ namespace xrt_core { namespace xclbin_int {
 const axlf*
 get_axlf(xrtXclbinHandle);
 
+// get_axlf_meta() - Create axlf image without bitstream sections
+// The image can be loaded in place of the complete xclbin when the
+// xclbin is already loaded on the device.  For a lazily loaded
+// xclbin, the bitstream sections are not read from file.
+std::vector<char>
+get_axlf_meta(const xrt::xclbin& xclbin);
+
 // get_xclbin() - Convert handle to object
 xrt::xclbin
 get_xclbin(xrtXclbinHandle);
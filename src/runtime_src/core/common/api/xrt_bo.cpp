@@ -33,6 +33,8 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/shared_handle.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <map>
 #include <set>
@@ -112,6 +114,67 @@ send_exception_message(const std::string& msg)
   send_exception_message(msg.c_str());
 }
 
+using rect_type = xrt::bo::rect;
+using region_type = std::array<size_t, 3>;
+
+// Replace zero pitches of a rect with the pitches of packed rows and
+// slices of the region
+rect_type
+normalize(rect_type rect, const region_type& region)
+{
+  if (!rect.row_pitch)
+    rect.row_pitch = region[0];
+  if (!rect.slice_pitch)
+    rect.slice_pitch = region[1] * rect.row_pitch;
+  return rect;
+}
+
+// Throw if rows or slices of a region with normalized layout overlap
+void
+valid_layout_or_error(const rect_type& rect, const region_type& region)
+{
+  if (rect.row_pitch < region[0])
+    throw xrt_core::error(-EINVAL, "row pitch is smaller than region row");
+  if (rect.slice_pitch < rect.row_pitch * region[1])
+    throw xrt_core::error(-EINVAL, "slice pitch is smaller than region slice");
+}
+
+// Bytes from first to last byte of a region with normalized layout
+size_t
+extent(const rect_type& rect, const region_type& region)
+{
+  if (!region[0] || !region[1] || !region[2])
+    return 0;
+
+  return (region[2] - 1) * rect.slice_pitch + (region[1] - 1) * rect.row_pitch + region[0];
+}
+
+// Call copy(dst_offset, src_offset, bytes) for each contiguous range
+// of a region with normalized layouts.  Rows that are packed in both
+// layouts are copied as one range, and so are slices.
+template <typename CopyFunction>
+void
+copy_rect(const rect_type& dst, const rect_type& src, const region_type& region, CopyFunction&& copy)
+{
+  auto bytes = region[0];
+  auto rows = region[1];
+  auto slices = region[2];
+  if (dst.row_pitch == bytes && src.row_pitch == bytes) {
+    bytes *= rows;
+    rows = 1;
+    if (dst.slice_pitch == bytes && src.slice_pitch == bytes) {
+      bytes *= slices;
+      slices = 1;
+    }
+  }
+
+  for (size_t z = 0; z < slices; ++z)
+    for (size_t y = 0; y < rows; ++y)
+      copy(dst.offset + z * dst.slice_pitch + y * dst.row_pitch,
+           src.offset + z * src.slice_pitch + y * src.row_pitch,
+           bytes);
+}
+
 } // namespace
 
 namespace {
@@ -360,6 +423,36 @@ public:
     std::memcpy(dst, hbuf, sz);
   }
 
+  // Layouts are normalized
+  void
+  valid_rect_or_error(const rect_type& bo_rect, const region_type& region) const
+  {
+    if (bo_rect.offset + extent(bo_rect, region) > size)
+      throw xrt_core::error(-EINVAL,"region extends past buffer size");
+  }
+
+  virtual void
+  write(const void* src, const rect_type& src_rect, const rect_type& bo_rect, const region_type& region)
+  {
+    valid_rect_or_error(bo_rect, region);
+    auto hbuf = static_cast<char*>(get_hbuf_or_error());
+    auto sbuf = static_cast<const char*>(src);
+    copy_rect(bo_rect, src_rect, region, [hbuf, sbuf](size_t dst_offset, size_t src_offset, size_t bytes) {
+      std::memcpy(hbuf + dst_offset, sbuf + src_offset, bytes);
+    });
+  }
+
+  virtual void
+  read(void* dst, const rect_type& dst_rect, const rect_type& bo_rect, const region_type& region)
+  {
+    valid_rect_or_error(bo_rect, region);
+    auto hbuf = static_cast<const char*>(get_hbuf_or_error());
+    auto dbuf = static_cast<char*>(dst);
+    copy_rect(dst_rect, bo_rect, region, [hbuf, dbuf](size_t dst_offset, size_t src_offset, size_t bytes) {
+      std::memcpy(dbuf + dst_offset, hbuf + src_offset, bytes);
+    });
+  }
+
   virtual void
   copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
   {
@@ -473,6 +566,23 @@ public:
     m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), sz, dir);
   }
 
+  // Sync ranges of this buffer, the ranges are sorted by offset and
+  // do not overlap
+  virtual void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges)
+  {
+    handle->sync_ranges(static_cast<xrt_core::buffer_handle::direction>(dir), ranges);
+    for (const auto& range : ranges)
+      m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), range.size, dir);
+  }
+
+  // Parent of a sub-buffer
+  virtual bo_impl*
+  get_parent() const
+  {
+    return nullptr;
+  }
+
   virtual uint64_t
   get_address() const
   {
@@ -834,6 +944,26 @@ public:
       throw xrt_core::error(-EINVAL,"attempting to write past buffer size");
     device->unmgd_pwrite(src, sz, get_address() + seek);
   }
+
+  void
+  write(const void* src, const rect_type& src_rect, const rect_type& bo_rect, const region_type& region) override
+  {
+    valid_rect_or_error(bo_rect, region);
+    auto sbuf = static_cast<const char*>(src);
+    copy_rect(bo_rect, src_rect, region, [this, sbuf](size_t dst_offset, size_t src_offset, size_t bytes) {
+      device->unmgd_pwrite(sbuf + src_offset, bytes, get_address() + dst_offset);
+    });
+  }
+
+  void
+  read(void* dst, const rect_type& dst_rect, const rect_type& bo_rect, const region_type& region) override
+  {
+    valid_rect_or_error(bo_rect, region);
+    auto dbuf = static_cast<char*>(dst);
+    copy_rect(dst_rect, bo_rect, region, [this, dbuf](size_t dst_offset, size_t src_offset, size_t bytes) {
+      device->unmgd_pread(dbuf + dst_offset, bytes, get_address() + src_offset);
+    });
+  }
 };
 
 class buffer_nodma : public bo_impl
@@ -881,6 +1011,13 @@ public:
     }
   }
 
+  void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges) override
+  {
+    for (const auto& range : ranges)
+      sync(dir, range.size, range.offset);
+  }
+
   void
   copy(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset) override
   {
@@ -947,6 +1084,24 @@ public:
     // sync through parent buffer, which handles nodma case also
     m_parent->sync(dir, sz, off);
   }
+
+  void
+  sync_ranges(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::range>& ranges) override
+  {
+    auto parent_ranges = ranges;
+    for (auto& range : parent_ranges) {
+      range.offset += m_offset;
+      if (range.offset + range.size > m_parent->get_size())
+        throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing sub buffer");
+    }
+    m_parent->sync_ranges(dir, parent_ranges);
+  }
+
+  bo_impl*
+  get_parent() const override
+  {
+    return m_parent.get();
+  }
 };
 
 // class buffer_xbuf - Wrapper for extern managed xclBufferHandle
@@ -982,6 +1137,12 @@ public:
     throw xrt_core::error(std::errc::not_supported, "no sync of xcl managed BOs");
   }
 
+  void
+  sync_ranges(xclBOSyncDirection, const std::vector<xrt_core::buffer_handle::range>&) override
+  {
+    throw xrt_core::error(std::errc::not_supported, "no sync of xcl managed BOs");
+  }
+
   bool
   is_sub() const override
   {
@@ -1514,6 +1675,38 @@ sync(xclBOSyncDirection dir, size_t size, size_t offset)
     });
 }
 
+void
+bo::
+sync(xclBOSyncDirection dir, const rect& bo_rect, const std::array<size_t, 3>& region)
+{
+  auto layout = normalize(bo_rect, region);
+  valid_layout_or_error(layout, region);
+  handle->valid_rect_or_error(layout, region);
+  auto size = extent(layout, region);
+  if (!size)
+    return;
+
+  // Syncing the gaps between rows from device is harmless, so the
+  // range spanned by the region is synced in one transfer
+  if (dir == XCL_BO_SYNC_BO_FROM_DEVICE) {
+    sync(dir, size, layout.offset);
+    return;
+  }
+
+  // Gaps between rows must not be synced to device, the host buffer
+  // may be stale there
+  std::vector<xrt_core::buffer_handle::range> ranges;
+  size = 0;
+  copy_rect(layout, layout, region, [&ranges, &size](size_t offset, size_t, size_t bytes) {
+    ranges.push_back({bytes, offset});
+    size += bytes;
+  });
+
+  xdp::native::profiling_wrapper_sync("xrt::bo::sync", dir, size, [this, dir, &ranges]{
+    handle->sync_ranges(dir, ranges);
+  });
+}
+
 bo::async_handle
 bo::
 async(xclBOSyncDirection dir, size_t sz, size_t offset)
@@ -1557,6 +1750,32 @@ read(void* dst, size_t size, size_t skip)
   });
 }
 
+void
+bo::
+write(const void* src, const rect& src_rect, const rect& bo_rect, const std::array<size_t, 3>& region)
+{
+  xdp::native::profiling_wrapper("xrt::bo::write", [this, src, &src_rect, &bo_rect, &region]{
+    auto src_layout = normalize(src_rect, region);
+    auto bo_layout = normalize(bo_rect, region);
+    valid_layout_or_error(src_layout, region);
+    valid_layout_or_error(bo_layout, region);
+    handle->write(src, src_layout, bo_layout, region);
+  });
+}
+
+void
+bo::
+read(void* dst, const rect& dst_rect, const rect& bo_rect, const std::array<size_t, 3>& region)
+{
+  xdp::native::profiling_wrapper("xrt::bo::read", [this, dst, &dst_rect, &bo_rect, &region]{
+    auto dst_layout = normalize(dst_rect, region);
+    auto bo_layout = normalize(bo_rect, region);
+    valid_layout_or_error(dst_layout, region);
+    valid_layout_or_error(bo_layout, region);
+    handle->read(dst, dst_layout, bo_layout, region);
+  });
+}
+
 void
 bo::
 copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
@@ -1570,6 +1789,58 @@ copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
 bo::
 ~bo() = default;
 
+void
+sync_many(const xrt::detail::span<const bo_sync_range>& ranges)
+{
+  xdp::native::profiling_wrapper("xrt::sync_many", [&ranges]{
+    using range_type = xrt_core::buffer_handle::range;
+    using key_type = std::pair<bo_impl*, xclBOSyncDirection>;
+
+    // Ranges grouped by root buffer and direction in order of first
+    // appearance.  Validate all ranges before syncing any.
+    std::map<key_type, size_t> index;
+    std::vector<std::pair<key_type, std::vector<range_type>>> buffers;
+    for (const auto& r : ranges) {
+      auto boh = r.bo.get_handle().get();
+      if (!boh)
+        throw xrt_core::error(-EINVAL, "Invalid buffer in sync range");
+      if (r.offset + r.size > boh->get_size())
+        throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing buffer range");
+      if (!r.size)
+        continue;
+
+      // Sub-buffer ranges are synced through the root buffer
+      auto offset = r.offset;
+      for (auto parent = boh->get_parent(); parent; parent = boh->get_parent()) {
+        offset += boh->get_offset();
+        boh = parent;
+      }
+
+      key_type key{boh, r.dir};
+      auto itr = index.emplace(key, buffers.size()).first;
+      if (itr->second == buffers.size())
+        buffers.emplace_back(key, std::vector<range_type>{});
+      buffers[itr->second].second.push_back({r.size, offset});
+    }
+
+    for (auto& [key, list] : buffers) {
+      // Merge overlapping and adjacent ranges
+      std::sort(list.begin(), list.end(), [](const auto& r1, const auto& r2) { return r1.offset < r2.offset; });
+      std::vector<range_type> merged;
+      for (const auto& r : list) {
+        if (!merged.empty() && r.offset <= merged.back().offset + merged.back().size) {
+          auto& last = merged.back();
+          last.size = std::max(last.offset + last.size, r.offset + r.size) - last.offset;
+          continue;
+        }
+        merged.push_back(r);
+      }
+
+      key.first->sync_ranges(key.second, merged);
+    }
+  });
+}
+
 } // xrt
 
 ////////////////////////////////////////////////////////////////
@@ -61,6 +61,7 @@
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <tuple>
 #include <fstream>
 #include <type_traits>
 #include <utility>
@@ -370,6 +371,7 @@ struct device_type
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
+    exec_buffer_cache.prewarm(xrt_core::config::get_exec_buffer_cache_prewarm());
   }
 
   explicit
@@ -379,6 +381,7 @@ struct device_type
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
+    exec_buffer_cache.prewarm(xrt_core::config::get_exec_buffer_cache_prewarm());
   }
 
   // NOLINTNEXTLINE(modernize-use-equals-default)
@@ -572,19 +575,38 @@ public:
     // The function also ensures that different devices can share same
     // hwctx handle, implying that even for same handle index, the CU
     // should be opened again if the device is different
-    using ctx_ips = std::map<std::string, std::weak_ptr<ip_context>>;
+    //
+    // The global lock only protects lookup of the per IP entry.  The
+    // context is opened under the entry lock, so that opening the
+    // same IP is serialized while different IPs are opened
+    // concurrently.
+    struct ip_entry
+    {
+      std::mutex mutex;
+      std::weak_ptr<ip_context> ipctx;
+    };
+    using ctx_ips = std::map<std::string, std::shared_ptr<ip_entry>>;
     using ctx_to_ips = std::map<const xrt_core::hwctx_handle*, ctx_ips>;
     static std::mutex mutex;
     static std::map<xrt_core::device*, ctx_to_ips> dev2ips;
     auto device = xrt_core::hw_context_int::get_core_device_raw(hwctx);
     auto hwctx_hdl = static_cast<xrt_core::hwctx_handle*>(hwctx);
-    std::lock_guard<std::mutex> lk(mutex);
-    auto& ctx2ips = dev2ips[device]; // hwctx handle -> [ip_context]*
-    auto& ips = ctx2ips[hwctx_hdl];     // ipname -> ip_context
-    auto ipctx = ips[ip.get_name()].lock();
+    std::shared_ptr<ip_entry> entry;
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      auto& ctx2ips = dev2ips[device]; // hwctx handle -> [ip_context]*
+      auto& ips = ctx2ips[hwctx_hdl];     // ipname -> ip_context
+      auto& ipentry = ips[ip.get_name()];
+      if (!ipentry)
+        ipentry = std::make_shared<ip_entry>();
+      entry = ipentry;
+    }
+
+    std::lock_guard<std::mutex> lk(entry->mutex);
+    auto ipctx = entry->ipctx.lock();
     if (!ipctx)
       // NOLINTNEXTLINE(modernize-make-shared)  used in weak_ptr
-      ips[ip.get_name()] = ipctx = std::shared_ptr<ip_context>(new ip_context(hwctx, ip));
+      entry->ipctx = ipctx = std::shared_ptr<ip_context>(new ip_context(hwctx, ip));
 
     return ipctx;
   }
@@ -858,21 +880,104 @@ public:
       (*cb)(state);
   }
 
+  // Check if callbacks are registered, in which case execution
+  // of the command is managed
+  bool
+  has_callbacks() const
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_callbacks && !m_callbacks->empty();
+  }
+
+  // Transition command to running state prior to its submission.
+  // Return true if this execution is traced.
+  bool
+  prep_run()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_done)
+      throw std::runtime_error("bad command state, can't launch");
+    m_managed = (m_callbacks && !m_callbacks->empty());
+    m_done = false;
+
+    // Trace this execution unless previous execution is still
+    // being traced, see release_trace()
+    bool traced = xrt_core::command_trace::enabled() && !m_trace_refs.load(std::memory_order_acquire);
+    if (traced)
+      m_trace_refs = 2;
+    m_traced = traced;
+    return traced;
+  }
+
+  // Submission of command prepared with prep_run() has returned
+  void
+  submitted(bool traced)
+  {
+    if (traced)
+      release_trace();
+  }
+
+  // Submission of command prepared with prep_run() failed
+  void
+  submit_failed(bool traced)
+  {
+    if (traced) {
+      m_trace.reset();
+      m_trace_refs = 0;
+    }
+  }
+
+  // Revert prep_run() for a command that was never submitted
+  void
+  cancel_run(bool traced)
+  {
+    submit_failed(traced);
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_done = true;
+  }
+
   // Submit the command for execution.
   void
   run()
   {
-    {
-      std::lock_guard<std::mutex> lk(m_mutex);
-      if (!m_done)
-        throw std::runtime_error("bad command state, can't launch");
-      m_managed = (m_callbacks && !m_callbacks->empty());
-      m_done = false;
+    auto traced = prep_run();
+    try {
+      if (m_managed)
+        m_hwqueue.managed_start(this);
+      else
+        m_hwqueue.unmanaged_start(this);
     }
-    if (m_managed)
-      m_hwqueue.managed_start(this);
-    else
-      m_hwqueue.unmanaged_start(this);
+    catch (...) {
+      submit_failed(traced);
+      throw;
+    }
+
+    submitted(traced);
+  }
+
+  // Record time point prior to execution of this command, e.g
+  // argument encoding.  Ignored if tracing is disabled or if the
+  // previous execution is still being traced.
+  void
+  trace(xrt_core::command_trace::point p)
+  {
+    if (xrt_core::command_trace::enabled() && !m_trace_refs.load(std::memory_order_acquire))
+      m_trace.stamp(p);
+  }
+
+  void
+  trace_once(xrt_core::command_trace::point p)
+  {
+    if (xrt_core::command_trace::enabled() && !m_trace_refs.load(std::memory_order_acquire))
+      m_trace.stamp_once(p);
+  }
+
+  // Trace record of most recently completed traced execution
+  xrt_core::command_trace::record
+  get_last_trace() const
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_last_trace;
   }
 
   // Wait for command completion
@@ -937,11 +1042,18 @@ public:
       : nullptr;
   }
 
+  xrt_core::command_trace::record*
+  get_trace() const override
+  {
+    return m_traced ? &m_trace : nullptr;
+  }
+
   void
   notify(ert_cmd_state s) const override
   {
     bool complete = false;
     bool callbacks = false;
+    bool traced = false;
     if (s >= ERT_CMD_STATE_COMPLETED) {
       std::lock_guard<std::mutex> lk(m_mutex);
 
@@ -954,12 +1066,19 @@ public:
       XRT_DEBUGF("kernel_command::notify() m_uid(%d) m_state(%d)\n", m_uid, s);
       complete = m_done = true;
       callbacks = (m_callbacks && !m_callbacks->empty());
+      traced = m_traced;
+      if (traced)
+        m_trace.stamp(xrt_core::command_trace::point::complete);
     }
 
     if (complete) {
       m_exec_done.notify_all();
       if (callbacks)
         run_callbacks(s);
+      if (traced) {
+        m_trace.stamp(xrt_core::command_trace::point::notify);
+        release_trace();
+      }
     }
   }
 
@@ -973,6 +1092,31 @@ public:
   }
 
 private:
+  // The trace record of an execution is written by the submitting
+  // thread and by the thread observing completion.  Each releases
+  // the record when done and the last one commits it.  The last
+  // releaser takes the record before dropping its reference, since
+  // the next execution of the command writes m_trace once the
+  // reference count is zero.
+  void
+  release_trace() const
+  {
+    auto refs = m_trace_refs.load(std::memory_order_acquire);
+    while (refs > 1 && !m_trace_refs.compare_exchange_weak(refs, refs - 1, std::memory_order_acq_rel))
+      ;
+    if (refs > 1)
+      return;
+
+    auto record = m_trace;
+    m_trace.reset();
+    record.uid = m_uid;
+    m_trace_refs.store(0, std::memory_order_release);
+
+    xrt_core::command_trace::commit(record);
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_last_trace = record;
+  }
+
   std::shared_ptr<device_type> m_device;
   xrt_core::hw_queue m_hwqueue;  // hwqueue for command submission
   xrt::hw_context m_hwctx;       // hw_context for command
@@ -985,6 +1129,12 @@ private:
   mutable std::condition_variable m_exec_done;
 
   std::unique_ptr<callback_list> m_callbacks;
+
+  // Command trace of current execution, see command_trace.h
+  mutable xrt_core::command_trace::record m_trace;
+  mutable xrt_core::command_trace::record m_last_trace;
+  mutable std::atomic<int> m_trace_refs {0};
+  std::atomic<bool> m_traced {false};
 };
 
 // class argument - get argument value from va_arg
@@ -1986,6 +2136,13 @@ class run_impl : public std::enable_shared_from_this<run_impl>
   using control_type = kernel_impl::control_type;
   using kernel_type = kernel_impl::kernel_type;
 
+  // Typed scalar encoder.  An encoder writes a fixed width argument
+  // value directly to the payload, without the virtual setter call
+  // and byte-wise copy of the generic path.  Encoders are specialized
+  // per control protocol and word type, and are resolved per argument
+  // when the argument setter of a run is created.
+  using encoder_type = void (*)(uint8_t* data, const argument& arg, const void* value);
+
   // Helper hierarchy to set argument value per control protocol type
   // The @data member is the payload to be populated with argument
   // value.  The interpretation of the payload depends on the control
@@ -2022,16 +2179,58 @@ class run_impl : public std::enable_shared_from_this<run_impl>
 
     virtual arg_range<uint8_t>
     get_arg_value(const argument& arg) = 0;
+
+    // Typed encoder for argument, or nullptr if argument must be set
+    // through this setter
+    virtual encoder_type
+    get_encoder(const argument&) const
+    {
+      return nullptr;
+    }
+
+    template <template <typename> typename Encoder>
+    static encoder_type
+    get_scalar_encoder(const argument& arg)
+    {
+      if (arg.type() != xrt_core::xclbin::kernel_argument::argtype::scalar)
+        return nullptr;
+
+      switch (arg.size()) {
+      case sizeof(uint32_t):
+        return &Encoder<uint32_t>::encode;
+      case sizeof(uint64_t):
+        return &Encoder<uint64_t>::encode;
+      default:
+        return nullptr;
+      }
+    }
   };
 
   // AP_CTRL_HS, AP_CTRL_CHAIN
   struct hs_arg_setter : arg_setter
   {
+    template <typename WordType>
+    struct encoder
+    {
+      static void
+      encode(uint8_t* data, const argument& arg, const void* value)
+      {
+        // fixed size copy compiles to a single word store
+        std::memcpy(data + arg.offset(), value, sizeof(WordType));
+      }
+    };
+
     explicit
     hs_arg_setter(uint32_t* data)
       : arg_setter(data)
     {}
 
+    encoder_type
+    get_encoder(const argument& arg) const override
+    {
+      return get_scalar_encoder<encoder>(arg);
+    }
+
     void
     set_offset_value(size_t offset, const arg_range<uint8_t>& value) override
     {
@@ -2057,11 +2256,31 @@ class run_impl : public std::enable_shared_from_this<run_impl>
   // FAST_ADAPTER
   struct fa_arg_setter : arg_setter
   {
+    template <typename WordType>
+    struct encoder
+    {
+      static void
+      encode(uint8_t* data, const argument& arg, const void* value)
+      {
+        auto desc = reinterpret_cast<ert_fa_descriptor*>(data);
+        auto desc_entry = reinterpret_cast<ert_fa_desc_entry*>(desc->data + arg.fa_desc_offset() / sizeof(uint32_t));
+        desc_entry->arg_offset = arg.offset();
+        desc_entry->arg_size = sizeof(WordType);
+        std::memcpy(desc_entry->arg_value, value, sizeof(WordType));
+      }
+    };
+
     explicit
     fa_arg_setter(uint32_t* data)
       : arg_setter(data)
     {}
 
+    encoder_type
+    get_encoder(const argument& arg) const override
+    {
+      return get_scalar_encoder<encoder>(arg);
+    }
+
     void
     set_offset_value(size_t offset, const arg_range<uint8_t>& value) override
     {
@@ -2147,15 +2366,70 @@ class run_impl : public std::enable_shared_from_this<run_impl>
     throw std::runtime_error("Internal error: xrt::kernel::make_arg_setter() not reachable");
   }
 
+  // Resolve typed encoder of each argument per the argument setter
+  void
+  init_encoders()
+  {
+    if (!xrt_core::config::get_typed_arg_encoding())
+      return;
+
+    for (const auto& arg : kernel->get_args()) {
+      if (arg.index() == argument::no_index)
+        break;
+      m_encoders.push_back(asetter->get_encoder(arg));
+    }
+  }
+
   arg_setter*
   get_arg_setter()
   {
-    if (!asetter)
+    if (!asetter) {
       asetter = make_arg_setter();
+      init_encoders();
+    }
 
     return asetter.get();
   }
 
+  // Typed encoder for argument value of specified size, or nullptr
+  // if the value must be set through the argument setter
+  encoder_type
+  get_encoder(const argument& arg, size_t bytes)
+  {
+    get_arg_setter();
+    return (arg.index() < m_encoders.size() && bytes == arg.size())
+      ? m_encoders[arg.index()]
+      : nullptr;
+  }
+
+  // Check if argument at index is already set to the buffer.  Mailbox
+  // run objects override to write all arguments to the mailbox.
+  virtual bool
+  is_arg_bo(size_t index, const xrt::bo& bo) const
+  {
+    if (index >= m_arg_bos.size())
+      return false;
+
+    auto handle = m_arg_bos[index].lock();
+    return handle && handle == bo.get_handle();
+  }
+
+  void
+  set_arg_bo(size_t index, const xrt::bo& bo)
+  {
+    if (index >= m_arg_bos.size())
+      m_arg_bos.resize(index + 1);
+    m_arg_bos[index] = bo.get_handle();
+  }
+
+  // Argument at index is encoded with a value not tracked as a buffer
+  void
+  reset_arg_bo(size_t index)
+  {
+    if (index < m_arg_bos.size())
+      m_arg_bos[index].reset();
+  }
+
   bool
   validate_ip_arg_connectivity(size_t argidx, int32_t grpidx)
   {
@@ -2273,10 +2547,17 @@ class run_impl : public std::enable_shared_from_this<run_impl>
   uint32_t m_header;                      // cached intialized command header
   uint32_t uid;                           // internal unique id for debug
   std::unique_ptr<arg_setter> asetter;    // helper to populate payload data
+  std::vector<encoder_type> m_encoders;   // typed encoder per argument index
   bool encode_cumasks = false;            // indicate if cmd cumasks must be re-encoded
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
 
+  // Buffers currently encoded in the command packet per argument
+  // index.  The command packet persists across starts, so setting a
+  // global argument to the buffer already encoded is a no-op and a
+  // restart re-encodes and re-patches only the arguments that changed.
+  std::vector<std::weak_ptr<xrt::bo_impl>> m_arg_bos;
+
   const runlist_impl* m_runlist = nullptr;// runlist that owns this run (optional)
   std::mutex m_mutex;                     // mutex synchronization
 
@@ -2408,6 +2689,13 @@ public:
     m_runlist = nullptr;
   }
 
+  bool
+  in_runlist()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_runlist != nullptr;
+  }
+
   // Use to explicitly restrict what CUs can be used
   // Specified CUs are ignored if they are not currently
   // managed by this run object
@@ -2448,12 +2736,14 @@ public:
   void
   set_arg_value(const argument& arg, const arg_range<uint8_t>& value)
   {
+    reset_arg_bo(arg.index());
     get_arg_setter()->set_arg_value(arg, value);
   }
 
   void
   set_arg_value(const argument& arg, const xrt::bo& bo)
   {
+    reset_arg_bo(arg.index());
     get_arg_setter()->set_arg_value(arg, bo);
     cmd->bind_arg_at_index(arg.index(), bo);
 
@@ -2464,7 +2754,13 @@ public:
   void
   set_arg_value(const argument& arg, const void* value, size_t bytes)
   {
-    set_arg_value(arg, arg_range<uint8_t>{value, bytes});
+    if (auto encode = get_encoder(arg, bytes)) {
+      reset_arg_bo(arg.index());
+      encode(asetter->data, arg, value);
+    }
+    else {
+      set_arg_value(arg, arg_range<uint8_t>{value, bytes});
+    }
 
     if (m_module)
       xrt_core::module_int::patch(m_module, arg.name(), arg.index(), value, bytes);
@@ -2473,6 +2769,8 @@ public:
   void
   set_offset_value(uint32_t offset, const arg_range<uint8_t>& value)
   {
+    // offset may overlap any argument
+    m_arg_bos.clear();
     get_arg_setter()->set_offset_value(offset, value);
   }
 
@@ -2485,20 +2783,31 @@ public:
   void
   set_arg(const argument& arg, std::va_list* args)
   {
+    reset_arg_bo(arg.index());
     arg.set(get_arg_setter(), args);
   }
 
   void
   set_arg_at_index(size_t index, const xrt::bo& argbo)
   {
+    cmd->trace_once(xrt_core::command_trace::point::encode);
+    if (is_arg_bo(index, argbo))
+      return;
+
     auto bo = validate_bo_at_index(index, argbo);
     auto& arg = kernel->get_arg(index);
     set_arg_value(arg, bo);
+
+    // A local copy of the argument buffer must be refreshed when
+    // the argument is set again, so only track the buffer itself.
+    if (bo.get_handle() == argbo.get_handle())
+      set_arg_bo(index, bo);
   }
 
   void
   set_arg_at_index(size_t index, std::va_list* args)
   {
+    cmd->trace_once(xrt_core::command_trace::point::encode);
     auto& arg = kernel->get_arg(index);
     set_arg(arg, args);
   }
@@ -2506,6 +2815,7 @@ public:
   void
   set_arg_at_index(size_t index, const void* value, size_t bytes)
   {
+    cmd->trace_once(xrt_core::command_trace::point::encode);
     auto& arg = kernel->get_arg(index);
     set_arg_value(arg, value, bytes);
   }
@@ -2521,6 +2831,7 @@ public:
   void
   set_all_args(std::va_list* args)
   {
+    cmd->trace_once(xrt_core::command_trace::point::encode);
     for (auto& arg : kernel->get_args()) {
       if (arg.index() == argument::no_index)
         break;
@@ -2554,6 +2865,8 @@ public:
   void
   prep_start()
   {
+    cmd->trace(xrt_core::command_trace::point::start);
+
     if (m_module)
       // Sync the module to device to ensure any patches are applied,
       // noop if module patching hasn't changed since last sync.
@@ -2574,6 +2887,40 @@ public:
     XRT_DEBUG_CALL(debug_cmd_packet(kernel->get_name(), pkt));
   }
 
+  // Check if this run object can be started as part of a batch of
+  // independent run objects, see xrt::submit_batch().  Run objects
+  // with completion callbacks must be started individually.
+  virtual bool
+  is_batchable() const
+  {
+    return !cmd->has_callbacks();
+  }
+
+  // Prepare start of this run object as part of a batch, the
+  // batch transitions and submits the command.  The start time
+  // point is discarded if the batch is cancelled.
+  void
+  prep_batch_start()
+  {
+    if (m_runlist)
+      throw xrt_core::error("Run object belongs to a runlist and cannot be explicitly started");
+
+    prep_start();
+  }
+
+  // Log start of this run object after the batch has been submitted
+  void
+  log_batch_start()
+  {
+    m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
+  }
+
+  xrt_core::hw_queue&
+  get_hw_queue()
+  {
+    return m_hwqueue;
+  }
+
   // start() - start the run object (execbuf)
   virtual void
   start()
@@ -2848,6 +3195,13 @@ class mailbox_impl : public run_impl
       mbox->kernel->write_register_n(arg.offset(), arg.size() / wsize, data32 + arg.offset() / wsize);
     }
 
+    // arguments must be written to mailbox
+    encoder_type
+    get_encoder(const argument&) const override
+    {
+      return nullptr;
+    }
+
     arg_range<uint8_t>
     get_arg_value(const argument& arg) override
     {
@@ -3042,6 +3396,20 @@ public:
     // Regular start
     run_impl::start();
   }
+
+  // Mailbox start adjusts the command, start individually
+  bool
+  is_batchable() const override
+  {
+    return false;
+  }
+
+  // Mailbox arguments are written to hw when set
+  bool
+  is_arg_bo(size_t, const xrt::bo&) const override
+  {
+    return false;
+  }
 };
 
 // struct run_update_type - RTP update
@@ -3436,7 +3804,9 @@ public:
     : m_exec_buffer_cache{hwctx.get_device().get_handle(), 128}
     , m_hwctx{std::move(hwctx)}
     , m_hwqueue{m_hwctx}
-  {}
+  {
+    m_exec_buffer_cache.prewarm(xrt_core::config::get_exec_buffer_cache_prewarm());
+  }
 
   ~runlist_impl()
   {
@@ -3595,6 +3965,87 @@ public:
   }
 };
 
+// submit_run_batch() - Start independent run objects with one submission
+//
+// All run objects must share the hw queue of their hw context.  All
+// run objects, including those that cannot be batched, are validated
+// before any is changed, and prepared run objects are reverted if
+// preparation of a later run object fails.  Run objects that cannot
+// be batched are started individually after the batch is submitted.
+static void
+submit_run_batch(const xrt::detail::span<const xrt::run>& runs)
+{
+  if (runs.empty())
+    return;
+
+  const xrt_core::hw_queue_impl* hwqueue = nullptr;
+  for (const auto& run : runs) {
+    const auto& rimpl = run.get_handle();
+    if (!rimpl)
+      throw xrt_core::error("Cannot start uninitialized run object");
+
+    if (!rimpl->get_cmd()->is_done())
+      throw xrt_core::error("Run object in batch is already running");
+
+    if (rimpl->in_runlist())
+      throw xrt_core::error("Run object in batch belongs to a runlist and cannot be explicitly started");
+
+    auto qimpl = rimpl->get_hw_queue().get_handle().get();
+    if (hwqueue && qimpl != hwqueue)
+      throw xrt_core::error("Run objects in batch must be from the same hardware context");
+    hwqueue = qimpl;
+  }
+
+  std::vector<std::pair<kernel_command*, bool>> batch; // command, traced
+  std::vector<xrt_core::command*> cmds;
+  std::vector<run_impl*> batched;
+  std::vector<run_impl*> singles;
+  batch.reserve(runs.size());
+  cmds.reserve(runs.size());
+  batched.reserve(runs.size());
+
+  try {
+    for (const auto& run : runs) {
+      auto rimpl = run.get_handle().get();
+      if (!rimpl->is_batchable()) {
+        singles.push_back(rimpl);
+        continue;
+      }
+
+      rimpl->prep_batch_start();
+      auto cmd = rimpl->get_cmd();
+      batch.emplace_back(cmd, cmd->prep_run());
+      cmds.push_back(cmd);
+      batched.push_back(rimpl);
+    }
+  }
+  catch (...) {
+    for (auto [cmd, traced] : batch)
+      cmd->cancel_run(traced);
+    throw;
+  }
+
+  if (!cmds.empty()) {
+    try {
+      runs.front().get_handle()->get_hw_queue().unmanaged_start(cmds);
+    }
+    catch (...) {
+      for (auto [cmd, traced] : batch)
+        cmd->submit_failed(traced);
+      throw;
+    }
+
+    for (auto [cmd, traced] : batch)
+      cmd->submitted(traced);
+
+    for (auto rimpl : batched)
+      rimpl->log_batch_start();
+  }
+
+  for (auto rimpl : singles)
+    rimpl->start();
+}
+
 // runlist::command_error_impl is in anticipation of additional
 // implementation data over that of run::command_error_impl
 class runlist::command_error_impl : public run::command_error_impl
@@ -3710,6 +4161,78 @@ alloc_run(const std::shared_ptr<xrt::kernel_impl>& khdl)
     : std::make_unique<xrt::run_impl>(khdl);
 }
 
+// class kernel_cache - Shared kernel implementations per hw_context
+//
+// Constructing a kernel mines meta data, builds the argument table,
+// and opens CU contexts.  Kernels constructed from the same hardware
+// context with the same name are identical, so they share one
+// kernel_impl exactly like copies of an xrt::kernel object do.  The
+// cache is disabled by default and enabled with xrt.ini
+// Runtime.kernel_cache.
+//
+// The cache is keyed by hwctx handle, access mode, and kernel name.
+// It holds weak references, so a kernel_impl is destructed when the
+// last xrt::kernel referring to it goes away.  A kernel_impl holds
+// on to its hw_context, so a cached hwctx handle cannot be reused by
+// another hw_context while the entry is alive.
+class kernel_cache
+{
+  using key_type = std::tuple<const xrt_core::hwctx_handle*, xrt::hw_context::access_mode, std::string>;
+
+  // Prune expired entries when cache grows beyond this size
+  static constexpr size_t prune_threshold = 256;
+
+  std::mutex m_mutex;
+  std::map<key_type, std::weak_ptr<xrt::kernel_impl>> m_kernels;
+  size_t m_prune_size = prune_threshold;
+
+  void
+  prune()
+  {
+    for (auto itr = m_kernels.begin(); itr != m_kernels.end();) {
+      if (itr->second.expired())
+        itr = m_kernels.erase(itr);
+      else
+        ++itr;
+    }
+    m_prune_size = std::max(prune_threshold, m_kernels.size() * 2);
+  }
+
+public:
+  template <typename Alloc>
+  std::shared_ptr<xrt::kernel_impl>
+  get_or_create(const xrt::hw_context& hwctx, const std::string& name, Alloc&& alloc)
+  {
+    static bool enabled = xrt_core::config::get_kernel_cache();
+    if (!enabled)
+      return alloc();
+
+    key_type key{static_cast<xrt_core::hwctx_handle*>(hwctx), hwctx.get_mode(), name};
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      if (auto itr = m_kernels.find(key); itr != m_kernels.end())
+        if (auto kernel = itr->second.lock())
+          return kernel;
+    }
+
+    // Construct outside of lock, different kernels can be constructed
+    // concurrently.  If same kernel was constructed concurrently by
+    // another thread, then the first one cached wins.
+    auto kernel = alloc();
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto& entry = m_kernels[key];
+    if (auto cached = entry.lock())
+      return cached;
+
+    entry = kernel;
+    if (m_kernels.size() > m_prune_size)
+      prune();
+
+    return kernel;
+  }
+};
+
 static std::shared_ptr<xrt::kernel_impl>
 alloc_kernel(const std::shared_ptr<device_type>& dev,
 	     const xrt::uuid& xclbin_id,
@@ -3726,7 +4249,10 @@ alloc_kernel_from_ctx(const std::shared_ptr<device_type>& dev,
                       const std::string& name)
 {
   // Delegating constructor with no module
-  return std::make_shared<xrt::kernel_impl>(dev, hwctx, xrt::module{}, name);
+  static kernel_cache cache;
+  return cache.get_or_create(hwctx, name, [&] {
+    return std::make_shared<xrt::kernel_impl>(dev, hwctx, xrt::module{}, name);
+  });
 }
 
 static std::shared_ptr<xrt::kernel_impl>
@@ -3743,7 +4269,10 @@ alloc_kernel_from_name(const std::shared_ptr<device_type>& dev,
                        const xrt::hw_context& hwctx,
                        const std::string& name)
 {
-  return std::make_shared<xrt::kernel_impl>(dev, hwctx, name);
+  static kernel_cache cache;
+  return cache.get_or_create(hwctx, name, [&] {
+    return std::make_shared<xrt::kernel_impl>(dev, hwctx, name);
+  });
 }
 
 static std::shared_ptr<xrt::mailbox_impl>
@@ -3913,6 +4442,12 @@ pop_callback(const xrt::run& run)
   run.get_handle()->pop_callback();
 }
 
+xrt_core::command_trace::record
+get_command_trace(const xrt::run& run)
+{
+  return run.get_handle()->get_cmd()->get_last_trace();
+}
+
 xrt::xclbin::ip::control_type
 get_control_protocol(const xrt::run& run)
 {
@@ -4326,6 +4861,13 @@ reset()
   handle->reset();
 }
 
+void
+submit_batch(const xrt::detail::span<const xrt::run>& runs)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_submit_batch);
+  submit_run_batch(runs);
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
@@ -9,10 +9,12 @@
 #include "core/include/xrt/experimental/xrt_xclbin.h"
 
 #include "core/common/system.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/module_loader.h"
 #include "core/common/query_requests.h"
+#include "core/common/xclbin_checksum.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/xclbin_swemu.h"
 
@@ -24,9 +26,12 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include <numeric>
 #include <regex>
 #include <set>
@@ -100,6 +105,63 @@ copy_axlf(const axlf* top)
   return header;
 }
 
+// Sections that are not needed by the driver when the xclbin is
+// already loaded on the device
+static bool
+is_bitstream_section(uint32_t kind)
+{
+  switch (kind) {
+  case BITSTREAM:
+  case CLEARING_BITSTREAM:
+  case PDI:
+  case BITSTREAM_PARTIAL_PDI:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// strip_axlf() - Create axlf image without bitstream sections
+//
+// The image has the header and meta data sections of the xclbin
+// with section offsets adjusted to the smaller image.  Section data
+// is copied by the specified function, such that the bitstream
+// payload need not be in memory.  The signature of the xclbin, if
+// any, is not valid for the stripped image and is removed.
+template <typename CopySection>
+static std::vector<char>
+strip_axlf(const axlf* top, CopySection&& copy_section)
+{
+  std::vector<const axlf_section_header*> hdrs;
+  for (uint32_t idx = 0; idx < top->m_header.m_numSections; ++idx)
+    if (!is_bitstream_section(top->m_sections[idx].m_sectionKind))
+      hdrs.push_back(top->m_sections + idx);
+
+  auto align = [](uint64_t value) { return (value + 7) & ~uint64_t(7); };
+  auto header_size = sizeof(axlf) + (std::max<size_t>(hdrs.size(), 1) - 1) * sizeof(axlf_section_header);
+  auto size = align(header_size);
+  for (auto hdr : hdrs)
+    size = align(size + hdr->m_sectionSize);
+
+  std::vector<char> image(size);
+  auto stripped = reinterpret_cast<axlf*>(image.data());
+  std::memcpy(stripped, top, sizeof(axlf) - sizeof(axlf_section_header));
+  stripped->m_signature_length = -1;
+  stripped->m_header.m_length = size;
+  stripped->m_header.m_numSections = static_cast<uint32_t>(hdrs.size());
+
+  auto offset = align(header_size);
+  for (size_t idx = 0; idx < hdrs.size(); ++idx) {
+    auto& hdr = stripped->m_sections[idx];
+    hdr = *hdrs[idx];
+    hdr.m_sectionOffset = offset;
+    copy_section(hdrs[idx], image.data() + offset);
+    offset = align(offset + hdr.m_sectionSize);
+  }
+
+  return image;
+}
+
 // Default implementation to get the name of an element
 template <typename ElementType>
 static std::string
@@ -590,8 +652,14 @@ class xclbin_impl
   {
     static std::mutex m;
     std::lock_guard<std::mutex> lk(m);
-    if (!m_info)
+    if (!m_info) {
+      // Associate the xml with the xclbin uuid before the meta data
+      // is extracted, so it can be served from persistent cache
+      auto xml = get_axlf_section(EMBEDDED_METADATA);
+      if (xml.first)
+        xrt_core::xclbin::load_xml_metadata(xml.first, xml.second, get_uuid());
       m_info = std::make_unique<xclbin_info>(this);
+    }
     return m_info.get();
   }
 
@@ -628,6 +696,13 @@ public:
     throw std::runtime_error("not implemented");
   }
 
+  virtual
+  std::vector<char>
+  get_axlf_meta() const
+  {
+    throw std::runtime_error("not implemented");
+  }
+
   virtual
   uuid
   get_uuid() const
@@ -749,6 +824,26 @@ public:
   }
 };
 
+// get_target_type() - Target type per xclbin header mode
+static xclbin::target_type
+get_target_type(const axlf* top)
+{
+  switch (top->m_header.m_mode) {
+  case XCLBIN_FLAT:
+  case XCLBIN_PR:
+  case XCLBIN_TANDEM_STAGE2:
+  case XCLBIN_TANDEM_STAGE2_WITH_PR:
+    return xclbin::target_type::hw;
+  case XCLBIN_HW_EMU:
+  case XCLBIN_HW_EMU_PR:
+    return xclbin::target_type::hw_emu;
+  case XCLBIN_SW_EMU:
+    return xclbin::target_type::sw_emu;
+  default:
+    throw std::runtime_error("Invalid target target");
+  }
+}
+
 // class xclbin_full - Implementation of full xclbin
 //
 // A full xclbin is constructed from a file on disk or from a complete
@@ -816,6 +911,11 @@ public:
   xclbin_full(const std::string& filename)
     : m_axlf(read_xclbin(filename))
   {
+    if (xrt_core::xclbin::checksum::enabled()) {
+      auto path = xrt_core::environment::platform_path(filename).string();
+      xrt_core::xclbin::checksum::validate(path, reinterpret_cast<const axlf*>(m_axlf.data()), m_axlf.size());
+    }
+
     init();
   }
 
@@ -854,20 +954,7 @@ public:
   xclbin::target_type
   get_target_type() const override
   {
-    switch (m_top->m_header.m_mode) {
-    case XCLBIN_FLAT:
-    case XCLBIN_PR:
-    case XCLBIN_TANDEM_STAGE2:
-    case XCLBIN_TANDEM_STAGE2_WITH_PR:
-      return xclbin::target_type::hw;
-    case XCLBIN_HW_EMU:
-    case XCLBIN_HW_EMU_PR:
-      return xclbin::target_type::hw_emu;
-    case XCLBIN_SW_EMU:
-      return xclbin::target_type::sw_emu;
-    default:
-      throw std::runtime_error("Invalid target target");
-    }
+    return xrt::get_target_type(m_top);
   }
 
   std::pair<const char*, size_t>
@@ -904,6 +991,204 @@ public:
   {
     return m_top;
   }
+
+  std::vector<char>
+  get_axlf_meta() const override
+  {
+    return strip_axlf(m_top, [this](const axlf_section_header* hdr, char* dst) {
+      auto src = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
+      std::copy(src, src + hdr->m_sectionSize, dst);
+    });
+  }
+};
+
+// class xclbin_lazy - Implementation of lazily loaded xclbin
+//
+// Constructed from a file on disk when xrt.ini Runtime.xclbin_lazy_load
+// is enabled.  Only the axlf header and section headers are read on
+// construction, section data is read from the file when first
+// accessed.  The complete xclbin is read only if requested through
+// get_axlf(), which is avoided when loading an xclbin that is already
+// loaded on the device.
+class xclbin_lazy : public xclbin_impl
+{
+  std::string m_path;
+  mutable std::ifstream m_stream;
+  std::vector<char> m_header;  // axlf header and section headers
+  const axlf* m_top = nullptr; // axlf pointer to header, no section data
+  uuid m_uuid;                 // uuid of xclbin
+  uuid m_intf_uuid;
+
+  // sections read from file so far, protected by m_mutex
+  mutable std::mutex m_mutex;
+  mutable std::set<axlf_section_kind> m_loaded;
+  mutable std::multimap<axlf_section_kind, std::vector<char>> m_axlf_sections;
+  mutable std::vector<char> m_axlf; // complete xclbin if requested
+
+  void
+  read(uint64_t offset, char* dst, uint64_t size) const
+  {
+    m_stream.clear();
+    m_stream.seekg(static_cast<std::streamoff>(offset));
+    if (!m_stream.read(dst, static_cast<std::streamsize>(size)))
+      throw std::runtime_error("Failed to read xclbin '" + m_path + "'");
+  }
+
+  void
+  read_header()
+  {
+    m_header.resize(sizeof(axlf));
+    read(0, m_header.data(), m_header.size());
+
+    auto top = reinterpret_cast<const axlf*>(m_header.data());
+    if (strncmp(top->m_magic, "xclbin2", strlen("xclbin2")) != 0)
+      throw std::runtime_error("Invalid xclbin");
+
+    auto num_sections = top->m_header.m_numSections;
+    if (num_sections > XCLBIN_MAX_NUM_SECTION)
+      throw std::runtime_error("Invalid xclbin");
+
+    if (num_sections > 1) {
+      auto size = m_header.size();
+      m_header.resize(size + (num_sections - 1) * sizeof(axlf_section_header));
+      read(size, m_header.data() + size, m_header.size() - size);
+    }
+
+    m_top = reinterpret_cast<const axlf*>(m_header.data());
+    m_uuid = uuid(m_top->m_header.uuid);
+    m_intf_uuid = uuid(m_top->m_header.m_interface_uuid);
+  }
+
+  // Read sections of specified kind, same sections as xclbin_full.
+  // Must be called with m_mutex locked.
+  void
+  load_sections(axlf_section_kind kind) const
+  {
+    if (m_loaded.count(kind))
+      return;
+
+    std::vector<std::vector<char>> sections;
+    if (std::find(kinds.begin(), kinds.end(), kind) != kinds.end()) {
+      // account for multiple soft_kernel sections
+      for (auto hdr = xrt_core::xclbin::get_axlf_section(m_top, kind); hdr;
+           hdr = (kind == SOFT_KERNEL) ? ::xclbin::get_axlf_section_next(m_top, hdr, SOFT_KERNEL) : nullptr) {
+        std::vector<char> data(hdr->m_sectionSize);
+        read(hdr->m_sectionOffset, data.data(), data.size());
+        sections.push_back(std::move(data));
+      }
+    }
+
+    for (auto& data : sections)
+      m_axlf_sections.emplace(kind, std::move(data));
+    m_loaded.insert(kind);
+  }
+
+public:
+  explicit
+  xclbin_lazy(const std::string& filename)
+  {
+    if (filename.empty())
+      throw std::runtime_error("No xclbin specified");
+
+    m_path = xrt_core::environment::platform_path(filename).string();
+    m_stream.open(m_path, std::ios::binary);
+    if (!m_stream)
+      throw std::runtime_error("Failed to open file '" + m_path + "' for reading");
+
+    read_header();
+
+    // Sections are not read up front, so only the section headers
+    // can be validated
+    if (xrt_core::xclbin::checksum::enabled()) {
+      try {
+        m_stream.clear();
+        m_stream.seekg(0, std::ios::end);
+        xrt_core::xclbin::checksum::validate_headers(m_top, static_cast<size_t>(m_stream.tellg()));
+      }
+      catch (const std::exception& ex) {
+        throw std::runtime_error("Invalid xclbin '" + m_path + "': " + ex.what());
+      }
+    }
+  }
+
+  uuid
+  get_uuid() const override
+  {
+    return m_uuid;
+  }
+
+  uuid
+  get_interface_uuid() const override
+  {
+    return m_intf_uuid;
+  }
+
+  std::string
+  get_xsa_name() const override
+  {
+    return reinterpret_cast<const char*>(m_top->m_header.m_platformVBNV);
+  }
+
+  xclbin::target_type
+  get_target_type() const override
+  {
+    return xrt::get_target_type(m_top);
+  }
+
+  std::pair<const char*, size_t>
+  get_axlf_section(axlf_section_kind kind) const override
+  {
+    std::lock_guard lk(m_mutex);
+    load_sections(kind);
+    auto itr = m_axlf_sections.find(kind);
+    return itr != m_axlf_sections.end()
+      ? std::make_pair((*itr).second.data(), (*itr).second.size())
+      : std::make_pair(nullptr, size_t(0));
+  }
+
+  std::vector<std::pair<const char*, size_t>>
+  get_axlf_sections(axlf_section_kind kind) const override
+  {
+    std::lock_guard lk(m_mutex);
+    load_sections(kind);
+    std::vector<std::pair<const char*, size_t>> sections;
+    auto range = m_axlf_sections.equal_range(kind);
+    for (auto itr = range.first; itr != range.second; ++itr)
+      sections.emplace_back((*itr).second.data(), (*itr).second.size());
+    return sections;
+  }
+
+  const axlf*
+  get_axlf() const override
+  {
+    std::lock_guard lk(m_mutex);
+    if (m_axlf.empty()) {
+      std::vector<char> data(m_top->m_header.m_length);
+      read(0, data.data(), data.size());
+      auto top = reinterpret_cast<const axlf*>(data.data());
+      if (uuid(top->m_header.uuid) != m_uuid)
+        throw std::runtime_error("xclbin '" + m_path + "' changed after it was opened");
+      m_axlf = std::move(data);
+    }
+    return reinterpret_cast<const axlf*>(m_axlf.data());
+  }
+
+  // Raw xclbin data is the complete xclbin read by get_axlf()
+  const std::vector<char>&
+  get_data() const override
+  {
+    get_axlf();
+    return m_axlf;
+  }
+
+  std::vector<char>
+  get_axlf_meta() const override
+  {
+    std::lock_guard lk(m_mutex);
+    return strip_axlf(m_top, [this](const axlf_section_header* hdr, char* dst) {
+      read(hdr->m_sectionOffset, dst, hdr->m_sectionSize);
+    });
+  }
 };
 
 // class xclbin_repository::iterator_impl - implementation of iterator
@@ -1022,12 +1307,21 @@ public:
 ////////////////////////////////////////////////////////////////
 namespace xrt {
 
+static std::shared_ptr<xclbin_impl>
+create_xclbin(const std::string& filename)
+{
+  if (xrt_core::config::get_xclbin_lazy_load())
+    return std::make_shared<xclbin_lazy>(filename);
+
+  return std::make_shared<xclbin_full>(filename);
+}
+
 ////////////////////////////////////////////////////////////////
 // xrt::xclbin
 ////////////////////////////////////////////////////////////////
 xclbin::
 xclbin(const std::string& filename)
-  : detail::pimpl<xclbin_impl>(std::make_shared<xclbin_full>(filename))
+  : detail::pimpl<xclbin_impl>(create_xclbin(filename))
 {}
 
 xclbin::
@@ -1570,6 +1864,12 @@ get_xclbin(xrtXclbinHandle handle)
   return xrt::xclbin(xclbins.get_or_error(handle));
 }
 
+std::vector<char>
+get_axlf_meta(const xrt::xclbin& xclbin)
+{
+  return xclbin.get_handle()->get_axlf_meta();
+}
+
 std::pair<const char*, size_t>
 get_axlf_section(const xrt::xclbin& xclbin, axlf_section_kind kind)
 {
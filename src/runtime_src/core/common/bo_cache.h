@@ -5,14 +5,20 @@
 #ifndef core_common_bo_cache_h_
 #define core_common_bo_cache_h_
 
+#include "core/common/config_reader.h"
 #include "core/common/system.h"
 #include "core/common/device.h"
+#include "core/common/message.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/include/xrt/detail/ert.h"
 
-#include <vector>
-#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( push )
@@ -21,8 +27,19 @@
 
 namespace xrt_core {
 
-// Create a cache of CMD BO objects -- for now only used for M2M -- to reduce
-// the overhead of BO life cycle management.
+// Create a cache of CMD BO objects to reduce the overhead of BO life
+// cycle management.
+//
+// The cache is organized as per-thread magazines layered over a shared
+// depot.  A thread allocates from and releases to the magazine of its
+// shard, so concurrent threads rarely contend on the same mutex.  When
+// a magazine runs empty it is refilled with a full magazine from the
+// depot, when it is full it is moved to the depot.  Only when both
+// the magazine and the depot are empty is a new exec BO allocated.
+//
+// The cache can be pre-warmed to avoid allocations on first use, and
+// hit/miss counters are logged on destruction if
+// Runtime.exec_buffer_cache_stats is enabled in xrt.ini.
 template <size_t BoSize>
 class bo_cache_t {
 public:
@@ -30,7 +47,27 @@ public:
   // pair is immutable. The clients should not change the contents of cmd_bo.
   template <typename CommandType>
   using cmd_bo = std::pair<std::unique_ptr<buffer_handle>, CommandType *const>;
+
+  struct stats
+  {
+    uint64_t hits;        // served from the magazine of the thread
+    uint64_t depot_hits;  // served after refill from the depot
+    uint64_t misses;      // allocated from the device
+    uint64_t evictions;   // released to the device because cache was full
+  };
+
 private:
+  using magazine = std::vector<cmd_bo<void>>;
+
+  // Shards are cache line aligned to avoid false sharing between threads
+  struct alignas(64) shard
+  {
+    std::mutex mutex;
+    magazine bos;
+  };
+
+  static constexpr size_t max_shards = 16;
+  static constexpr size_t max_magazine_size = 16;
 
   // We are really allocating a page size as that is what xocl/zocl do. Note on
   // POWER9 pagesize maybe more than 4K, xocl would upsize the allocation to the
@@ -40,29 +77,88 @@ private:
   // Maximum number of BOs that can be cached in the pool. Value of 0 indicates
   // caching should be disabled.
   const unsigned int m_cache_max_size;
-  std::vector<cmd_bo<void>> m_cmd_bo_cache;
+  const size_t m_num_shards;
+  const size_t m_magazine_size;
+  std::unique_ptr<shard[]> m_shards;   // NOLINT, shard is not movable
+
+  // Depot of full magazines
+  std::vector<magazine> m_depot;
   std::mutex m_mutex;
 
+  std::atomic<size_t> m_cached {0};
+  std::atomic<uint64_t> m_hits {0};
+  std::atomic<uint64_t> m_depot_hits {0};
+  std::atomic<uint64_t> m_misses {0};
+  std::atomic<uint64_t> m_evictions {0};
+
+  static size_t
+  get_num_shards(unsigned int max_size)
+  {
+    // Half of the cache capacity is spread over the shards with at
+    // least two BOs per shard, remainder is depot
+    size_t cores = std::max(1U, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min({cores, max_shards, size_t(max_size / 4)}));
+  }
+
+  static size_t
+  get_magazine_size(unsigned int max_size, size_t num_shards)
+  {
+    return std::clamp<size_t>(max_size / (2 * num_shards), 1, max_magazine_size);
+  }
+
+  // Threads are assigned shards round robin on first use
+  shard&
+  get_shard()
+  {
+    static std::atomic<size_t> next_thread {0};
+    thread_local const size_t thread_idx = next_thread++;
+    return m_shards[thread_idx % m_num_shards];
+  }
+
 public:
   bo_cache_t(std::shared_ptr<xrt_core::device> device, unsigned int max_size)
-    : m_device(std::move(device)), m_cache_max_size(max_size)
+    : m_device(std::move(device))
+    , m_cache_max_size(max_size)
+    , m_num_shards(get_num_shards(max_size))
+    , m_magazine_size(get_magazine_size(max_size, m_num_shards))
+    , m_shards(std::make_unique<shard[]>(m_num_shards)) // NOLINT
   {}
 
   bo_cache_t(xclDeviceHandle handle, unsigned int max_size)
-    : m_device(get_userpf_device(handle)), m_cache_max_size(max_size)
+    : bo_cache_t(get_userpf_device(handle), max_size)
   {}
 
   ~bo_cache_t()
   {
     try {
+      if (config::get_exec_buffer_cache_stats()) {
+        auto s = get_stats();
+        message::send(message::severity_level::info, "XRT",
+                      "exec buffer cache: hits(%llu) depot_hits(%llu) misses(%llu) evictions(%llu)",
+                      static_cast<unsigned long long>(s.hits), static_cast<unsigned long long>(s.depot_hits),
+                      static_cast<unsigned long long>(s.misses), static_cast<unsigned long long>(s.evictions));
+      }
+
+      for (size_t idx = 0; idx < m_num_shards; ++idx) {
+        std::lock_guard<std::mutex> lock(m_shards[idx].mutex);
+        for (auto& bo : m_shards[idx].bos)
+          destroy(bo);
+      }
+
       std::lock_guard<std::mutex> lock(m_mutex);
-      for (auto& bo : m_cmd_bo_cache)
-        destroy(bo);
+      for (auto& mag : m_depot)
+        for (auto& bo : mag)
+          destroy(bo);
     }
     catch (...) {
     }
   }
 
+  bo_cache_t(const bo_cache_t&) = delete;
+  bo_cache_t(bo_cache_t&&) = delete;
+  bo_cache_t& operator=(const bo_cache_t&) = delete;
+  bo_cache_t& operator=(bo_cache_t&&) = delete;
+
   template<typename T>
   cmd_bo<T>
   alloc()
@@ -78,36 +174,92 @@ public:
     release_impl(std::make_pair(std::move(bo.first), static_cast<void *>(bo.second)));
   }
 
+  // Allocate count BOs up front and place them in the depot.  The
+  // count is capped by the max cache size.
+  void
+  prewarm(size_t count)
+  {
+    count = std::min<size_t>(count, m_cache_max_size);
+    magazine mag;
+    while (m_cached < count) {
+      mag.push_back(alloc_new());
+      ++m_cached;
+      if (mag.size() == m_magazine_size || m_cached == count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_depot.push_back(std::move(mag));
+        mag = magazine{};
+      }
+    }
+  }
+
+  stats
+  get_stats() const
+  {
+    return {m_hits.load(), m_depot_hits.load(), m_misses.load(), m_evictions.load()};
+  }
+
 private:
+  cmd_bo<void>
+  alloc_new()
+  {
+    auto execHandle = m_device->alloc_bo(m_bo_size, XCL_BO_FLAGS_EXECBUF);
+    auto map = execHandle->map(buffer_handle::map_type::write);
+    return std::make_pair(std::move(execHandle), map);
+  }
+
   cmd_bo<void>
   alloc_impl()
   {
     if (m_cache_max_size) {
-      // If caching is enabled first look up in the BO cache
-      std::lock_guard lock(m_mutex);
-      if (!m_cmd_bo_cache.empty()) {
-        auto bo = std::move(m_cmd_bo_cache.back());
-        m_cmd_bo_cache.pop_back();
+      // If caching is enabled first look up in the magazine of this
+      // thread, then refill the magazine from the depot
+      auto& sh = get_shard();
+      std::lock_guard lock(sh.mutex);
+      if (!sh.bos.empty()) {
+        auto bo = std::move(sh.bos.back());
+        sh.bos.pop_back();
+        --m_cached;
+        ++m_hits;
+        return bo;
+      }
+
+      std::lock_guard depot_lock(m_mutex);
+      if (!m_depot.empty()) {
+        sh.bos = std::move(m_depot.back());
+        m_depot.pop_back();
+        auto bo = std::move(sh.bos.back());
+        sh.bos.pop_back();
+        --m_cached;
+        ++m_depot_hits;
         return bo;
       }
     }
 
-    auto execHandle = m_device->alloc_bo(m_bo_size, XCL_BO_FLAGS_EXECBUF);
-    auto map = execHandle->map(buffer_handle::map_type::write);
-    return std::make_pair(std::move(execHandle), map);
+    ++m_misses;
+    return alloc_new();
   }
 
   void
   release_impl(cmd_bo<void>&& bo)
   {
-    if (m_cache_max_size) {
-      // If caching is enabled and BO cache is not fully populated add this the cache
-      std::lock_guard lock(m_mutex);
-      if (m_cmd_bo_cache.size() < m_cache_max_size) {
-        m_cmd_bo_cache.push_back(std::move(bo));
-        return;
+    // If caching is enabled and BO cache is not fully populated add
+    // this to the magazine of this thread
+    if (m_cache_max_size && m_cached++ < m_cache_max_size) {
+      auto& sh = get_shard();
+      std::lock_guard lock(sh.mutex);
+      if (sh.bos.size() >= m_magazine_size) {
+        std::lock_guard depot_lock(m_mutex);
+        m_depot.push_back(std::move(sh.bos));
+        sh.bos = magazine{};
+        sh.bos.reserve(m_magazine_size);
       }
+      sh.bos.push_back(std::move(bo));
+      return;
     }
+
+    if (m_cache_max_size)
+      --m_cached;
+    ++m_evictions;
     destroy(bo);
   }
 
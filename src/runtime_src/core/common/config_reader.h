@@ -240,6 +240,16 @@ get_trace_file_dump_interval_s()
   return value;
 }
 
+// Format of device trace files, "csv" or "binary".  Binary trace is
+// appended to a single file and converted to csv offline with
+// xdp_trace_convert.
+inline std::string
+get_device_trace_format()
+{
+  static std::string value = detail::get_string_value("Debug.device_trace_format", "csv");
+  return value;
+}
+
 inline std::string
 get_trace_buffer_size()
 {
@@ -393,6 +403,24 @@ get_logging()
   return value;
 }
 
+// Write runtime_log messages from a background thread, such that
+// raised verbosity does not stall the threads sending messages
+inline bool
+get_logging_async()
+{
+  static bool value = detail::get_bool_value("Runtime.runtime_log_async",false);
+  return value;
+}
+
+// Per thread number of messages pending asynchronous write, further
+// messages are dropped and counted
+inline unsigned int
+get_logging_async_queue_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.runtime_log_async_queue_size",1024);
+  return value;
+}
+
 inline bool
 get_trace_logging()
 {
@@ -464,6 +492,48 @@ get_platform_repo()
   return value;
 }
 
+// Directory of persistent cache with kernel meta data extracted from
+// xclbins.  Processes loading an xclbin already in the cache skip
+// parsing of its xml meta data.  Empty disables the cache.
+inline std::string
+get_xclbin_metadata_cache()
+{
+  static std::string value = detail::get_string_value("Runtime.xclbin_metadata_cache","");
+  return value;
+}
+
+// Load xclbin sections from file on first access rather than reading
+// the complete xclbin when constructing xrt::xclbin from a file.  Also
+// skips the bitstream payload when loading an xclbin that the device
+// reports as already loaded.
+inline bool
+get_xclbin_lazy_load()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_lazy_load",false);
+  return value;
+}
+
+// Validate xclbin section headers and section checksums when an
+// xclbin is loaded from file, see core/common/xclbin_checksum.h.
+// Section checksums are compared against those of the first load of
+// the same file, a file that is corrupt when first loaded is not
+// detected.
+inline bool
+get_xclbin_validate()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_validate",false);
+  return value;
+}
+
+// Directory for persisted xclbin validation results, empty to keep
+// results in process only
+inline std::string
+get_xclbin_validate_cache()
+{
+  static std::string value = detail::get_string_value("Runtime.xclbin_validate_cache","");
+  return value;
+}
+
 inline bool
 get_enable_flat()
 {
@@ -639,6 +709,27 @@ get_cmdbo_cache()
   return value;
 }
 
+/**
+ * Number of exec buffers to allocate up front when an exec buffer
+ * cache is created.  Capped by the size of the cache.
+ */
+inline unsigned int
+get_exec_buffer_cache_prewarm()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_buffer_cache_prewarm",0);
+  return value;
+}
+
+/**
+ * Log hit/miss statistics of exec buffer caches when destroyed
+ */
+inline bool
+get_exec_buffer_cache_stats()
+{
+  static bool value = detail::get_bool_value("Runtime.exec_buffer_cache_stats",false);
+  return value;
+}
+
 inline std::string
 get_hw_em_driver()
 {
@@ -736,6 +827,36 @@ get_exclusive_cu_context()
   return value;
 }
 
+// Share kernel implementations between xrt::kernel objects constructed
+// from same hardware context and kernel name.  Opt-in since separately
+// constructed kernels then share CU contexts and are no longer
+// independent objects.
+inline bool
+get_kernel_cache()
+{
+  static bool value = detail::get_bool_value("Runtime.kernel_cache", false);
+  return value;
+}
+
+// Record host side time points of command execution, see
+// core/common/api/command_trace.h
+inline bool
+get_command_trace()
+{
+  static bool value = detail::get_bool_value("Runtime.command_trace", false);
+  return value;
+}
+
+// Write fixed width scalar kernel arguments with typed encoders
+// rather than byte-wise copy through the argument setter.  Disable
+// to compare against the generic path.
+inline bool
+get_typed_arg_encoding()
+{
+  static bool value = detail::get_bool_value("Runtime.typed_arg_encoding", true);
+  return value;
+}
+
 inline bool
 get_flag_kds_sw_emu()
 {
@@ -799,6 +920,15 @@ get_flag_sw_emu_kernel_debug()
   return value;
 }
 
+// Transfer data to and from zero copy buffers in sw_emu through
+// memory shared with the device process rather than over the socket.
+inline bool
+get_sw_emu_shared_memory()
+{
+  static bool value = detail::get_bool_value("Emulation.sw_emu_shared_memory", true);
+  return value;
+}
+
 // This flag is added to exit device offline status check loop forcibly.
 // By default, device offline status loop runs for 320 seconds.
 inline unsigned int
@@ -1070,6 +1200,20 @@ get_aie_trace_settings_enable_system_timeline()
   return value;
 }
 
+inline bool
+get_aie_trace_settings_stream_to_file()
+{
+  static bool value = detail::get_bool_value("AIE_trace_settings.stream_to_file", false);
+  return value;
+}
+
+inline bool
+get_aie_trace_settings_direct_io()
+{
+  static bool value = detail::get_bool_value("AIE_trace_settings.direct_io", false);
+  return value;
+}
+
 inline std::string
 get_dtrace_lib_path()
 {
@@ -8,6 +8,7 @@
 #include "config_reader.h"
 #include "debug.h"
 #include "error.h"
+#include "message.h"
 #include "query_requests.h"
 #include "utils.h"
 #include "xclbin_parser.h"
@@ -136,6 +137,23 @@ record_xclbin(const xrt::xclbin& xclbin)
   m_xclbin = xclbin;
 }
 
+// Check if the device reports the xclbin as loaded, in which case
+// the driver does not need the bitstream sections.  Opt-in along
+// with lazy xclbin loading, and for hardware xclbins only.
+static bool
+is_xclbin_loaded(const device* dev, const xrt::xclbin& xclbin)
+{
+  if (!config::get_xclbin_lazy_load() || xclbin.get_target_type() != xrt::xclbin::target_type::hw)
+    return false;
+
+  try {
+    return dev->get_xclbin_uuid() == xclbin.get_uuid();
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
 // Unfortunately there are two independent entry points to load an
 // xclbin.  One is this function via xrt::device::load_xclbin(), the
 // other is xclLoadXclBin(). The two entrypoints converge in
@@ -146,8 +164,25 @@ void
 device::
 load_xclbin(const xrt::xclbin& xclbin)
 {
+  auto loaded = is_xclbin_loaded(this, xclbin);
   try {
     m_xclbin = xclbin;
+
+    // Skip reading and copying the bitstream payload when the xclbin
+    // is already loaded, fall back on the complete xclbin if the
+    // driver rejects the stripped image.
+    if (loaded) {
+      try {
+        auto meta = xclbin_int::get_axlf_meta(xclbin);
+        load_axlf(reinterpret_cast<const axlf*>(meta.data()));
+        return;
+      }
+      catch (const std::exception& ex) {
+        xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                                std::string("Loading xclbin without bitstream failed: ") + ex.what());
+      }
+    }
+
     load_axlf(xclbin.get_axlf());
   }
   catch (const std::exception&) {
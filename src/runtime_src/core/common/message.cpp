@@ -15,8 +15,13 @@
 #include <thread>
 #include <mutex>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstdlib>
 #include <climits>
+#include <memory>
 #ifdef __linux__
 # include <syslog.h>
 # include <linux/limits.h>
@@ -53,6 +58,7 @@ get_exe_path()
 
 
 using severity_level = xrt_core::message::severity_level;
+using time_point = std::chrono::system_clock::time_point;
 
 //--
 class message_dispatch
@@ -63,6 +69,13 @@ public:
   static message_dispatch* make_dispatcher(const std::string& choice);
 public:
   virtual void send(severity_level l, const char* tag, const char* msg) = 0;
+
+  // Write message sent at time by thread, used by async_dispatch.
+  // Output may be buffered until flush().
+  virtual void write(severity_level l, const char* tag, const char* msg, time_point, std::thread::id)
+  { send(l, tag, msg); }
+
+  virtual void flush() {}
 };
 
 //--
@@ -130,7 +143,10 @@ public:
   file_dispatch(const std::string& file);
   virtual ~file_dispatch();
   virtual void send(severity_level l, const char* tag, const char* msg) override;
+  virtual void write(severity_level l, const char* tag, const char* msg, time_point time, std::thread::id tid) override;
+  virtual void flush() override;
 private:
+  std::mutex mutex;
   std::ofstream handle;
   std::map<severity_level, const char*> severityMap = {
     { severity_level::emergency, "EMERGENCY: "},
@@ -144,10 +160,225 @@ private:
   };
 };
 
+//--
+// Asynchronous dispatch (xrt.ini Runtime.runtime_log_async=true)
+//
+// Messages are recorded unformatted in a bounded lock-free queue per
+// sending thread, and written by a flusher thread through the
+// configured dispatcher.  Formatting of timestamp, thread id, and
+// severity is deferred to the flusher.  A message is dropped if the
+// queue of the sending thread is full, the flusher reports the number
+// of dropped messages.  Pending messages are written at exit, after
+// which messages are written synchronously.
+class async_dispatch : public message_dispatch
+{
+public:
+  async_dispatch(std::unique_ptr<message_dispatch> sink, size_t queue_size);
+  virtual void send(severity_level l, const char* tag, const char* msg) override;
+  void stop();
+private:
+  struct record
+  {
+    severity_level level;
+    time_point time;
+    std::string tag;  // capacity is reused when slot is reused
+    std::string msg;
+  };
+
+  // Single producer (sending thread) single consumer (flusher) ring
+  struct thread_queue
+  {
+    std::vector<record> slots;
+    std::thread::id tid = std::this_thread::get_id();
+    std::atomic<size_t> head {0};        // next slot written by sender
+    std::atomic<size_t> tail {0};        // next slot read by flusher
+    std::atomic<uint64_t> dropped {0};
+    std::atomic<bool> closed {false};    // sending thread has exited
+
+    explicit
+    thread_queue(size_t size)
+      : slots(size)
+    {}
+  };
+
+  // Marks the queue of a thread closed when the thread exits
+  struct queue_owner
+  {
+    std::shared_ptr<thread_queue> queue;
+    ~queue_owner() { if (queue) queue->closed = true; }
+  };
+
+  struct pending
+  {
+    const record* rec;
+    std::thread::id tid;
+  };
+
+  std::unique_ptr<message_dispatch> m_sink;
+  size_t m_queue_size;
+  std::mutex m_mutex;                // queue registry
+  std::mutex m_sync_mutex;           // final drain, synchronous writes
+  std::condition_variable m_cv;
+  std::vector<std::shared_ptr<thread_queue>> m_queues;
+  std::atomic<bool> m_stop {false};  // flusher must exit
+  std::atomic<bool> m_sync {false};  // write synchronously after stop
+  std::atomic<unsigned int> m_senders {0}; // senders enqueuing a message
+  uint64_t m_dropped = 0;            // dropped by removed queues
+  uint64_t m_dropped_reported = 0;
+  std::thread m_flusher;
+
+  thread_queue* get_queue();
+  void drain();
+  void flush_loop();
+};
+
+async_dispatch::
+async_dispatch(std::unique_ptr<message_dispatch> sink, size_t queue_size)
+  : m_sink(std::move(sink))
+  , m_queue_size(std::max<size_t>(queue_size, 1))
+  , m_flusher(&async_dispatch::flush_loop, this)
+{}
+
+async_dispatch::thread_queue*
+async_dispatch::
+get_queue()
+{
+  static thread_local queue_owner owner;
+  if (!owner.queue) {
+    owner.queue = std::make_shared<thread_queue>(m_queue_size);
+    std::lock_guard lk(m_mutex);
+    m_queues.push_back(owner.queue);
+  }
+  return owner.queue.get();
+}
+
+void
+async_dispatch::
+send(severity_level l, const char* tag, const char* msg)
+{
+  // A sender is counted before checking m_sync, stop() sets m_sync
+  // and waits for counted senders before the final drain, so either
+  // the message is drained or it is written synchronously
+  ++m_senders;
+  if (m_sync) {
+    --m_senders;
+    std::lock_guard lk(m_sync_mutex);
+    m_sink->send(l, tag, msg);
+    return;
+  }
+
+  auto queue = get_queue();
+  auto head = queue->head.load(std::memory_order_relaxed);
+  auto used = head - queue->tail.load(std::memory_order_acquire);
+  if (used == queue->slots.size()) {
+    queue->dropped.fetch_add(1, std::memory_order_relaxed);
+    --m_senders;
+    return;
+  }
+
+  auto& rec = queue->slots[head % queue->slots.size()];
+  rec.level = l;
+  rec.time = std::chrono::system_clock::now();
+  rec.tag.assign(tag);
+  rec.msg.assign(msg);
+  queue->head.store(head + 1, std::memory_order_release);
+  --m_senders;
+
+  // wake flusher early if queue is filling up
+  if (used + 1 >= queue->slots.size() / 2)
+    m_cv.notify_one();
+}
+
+// Write pending messages of all threads in time order
+void
+async_dispatch::
+drain()
+{
+  std::vector<std::shared_ptr<thread_queue>> queues;
+  {
+    std::lock_guard lk(m_mutex);
+    queues = m_queues;
+  }
+
+  std::vector<pending> batch;
+  std::vector<size_t> heads;
+  uint64_t dropped = m_dropped;
+  for (const auto& queue : queues) {
+    auto tail = queue->tail.load(std::memory_order_relaxed);
+    auto head = queue->head.load(std::memory_order_acquire);
+    for (auto idx = tail; idx != head; ++idx)
+      batch.push_back({&queue->slots[idx % queue->slots.size()], queue->tid});
+    heads.push_back(head);
+    dropped += queue->dropped.load(std::memory_order_relaxed);
+  }
+
+  std::stable_sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.rec->time < rhs.rec->time;
+  });
+
+  for (const auto& p : batch)
+    m_sink->write(p.rec->level, p.rec->tag.c_str(), p.rec->msg.c_str(), p.rec->time, p.tid);
+
+  if (dropped > m_dropped_reported) {
+    auto msg = std::to_string(dropped - m_dropped_reported) + " messages dropped, increase Runtime.runtime_log_async_queue_size";
+    m_sink->write(severity_level::warning, "XRT", msg.c_str(), std::chrono::system_clock::now(), std::this_thread::get_id());
+    m_dropped_reported = dropped;
+  }
+
+  m_sink->flush();
+
+  // release written slots to senders
+  for (size_t idx = 0; idx < queues.size(); ++idx)
+    queues[idx]->tail.store(heads[idx], std::memory_order_release);
+
+  // remove drained queues of exited threads
+  std::lock_guard lk(m_mutex);
+  auto itr = std::remove_if(m_queues.begin(), m_queues.end(), [this](const auto& queue) {
+    if (!queue->closed || queue->tail != queue->head)
+      return false;
+    m_dropped += queue->dropped;
+    return true;
+  });
+  m_queues.erase(itr, m_queues.end());
+}
+
+void
+async_dispatch::
+flush_loop()
+{
+  constexpr auto interval = std::chrono::milliseconds(10);
+  while (!m_stop) {
+    {
+      std::unique_lock lk(m_mutex);
+      m_cv.wait_for(lk, interval, [this] { return m_stop.load(); });
+    }
+    drain();
+  }
+}
+
+void
+async_dispatch::
+stop()
+{
+  if (m_stop.exchange(true))
+    return;
+
+  m_cv.notify_one();
+  m_flusher.join();
+
+  // Switch to synchronous writes before the final drain and wait for
+  // senders that are still enqueuing
+  m_sync = true;
+  while (m_senders)
+    std::this_thread::yield();
+
+  std::lock_guard lk(m_sync_mutex);
+  drain();
+}
+
 //-------
-message_dispatch*
-message_dispatch::
-make_dispatcher(const std::string& choice)
+static message_dispatch*
+make_sink(const std::string& choice)
 {
   if( (choice == "null") || (choice == ""))
     return new null_dispatch;
@@ -172,6 +403,23 @@ make_dispatcher(const std::string& choice)
   }
 }
 
+// The async dispatcher is never deleted, it is stopped at exit
+static async_dispatch* s_async_dispatch = nullptr;
+
+message_dispatch*
+message_dispatch::
+make_dispatcher(const std::string& choice)
+{
+  auto sink = make_sink(choice);
+  if (!xrt_core::config::get_logging_async() || dynamic_cast<null_dispatch*>(sink))
+    return sink;
+
+  s_async_dispatch = new async_dispatch
+    (std::unique_ptr<message_dispatch>(sink), xrt_core::config::get_logging_async_queue_size());
+  std::atexit([] { s_async_dispatch->stop(); });
+  return s_async_dispatch;
+}
+
 //file ops
 file_dispatch::
 file_dispatch(const std::string &file)
@@ -196,11 +444,26 @@ void
 file_dispatch::
 send(severity_level l, const char* tag, const char* msg)
 {
-  static std::mutex mutex;
+  write(l, tag, msg, std::chrono::system_clock::now(), std::this_thread::get_id());
+  flush();
+}
+
+void
+file_dispatch::
+write(severity_level l, const char* tag, const char* msg, time_point time, std::thread::id tid)
+{
+  std::lock_guard<std::mutex> lk(mutex);
+  handle << "[" << xrt_core::timestamp(time) <<"] [" << tag << "] Tid: "
+         << tid << ", " << " " << severityMap[l]
+         << msg << '\n';
+}
+
+void
+file_dispatch::
+flush()
+{
   std::lock_guard<std::mutex> lk(mutex);
-  handle << "[" << xrt_core::timestamp() <<"] [" << tag << "] Tid: "
-         << std::this_thread::get_id() << ", " << " " << severityMap[l]
-         << msg << std::endl;
+  handle.flush();
 }
 
 //console ops
@@ -10,6 +10,7 @@
 
 #include "runner.h"
 #include "cpu.h"
+#include "validate.h"
 
 #include "core/common/debug.h"
 #include "core/common/dlfcn.h"
@@ -338,6 +339,64 @@ get(const std::string& path, const artifacts::repo* repo)
 
 } // module_cache
 
+// Buffer validation against golden data, see validate.h
+namespace validate {
+
+using namespace xrt_core::validate;
+
+// buffer() - Validate value buffer against gold buffer
+//
+// "validate": {
+//   "type": "fp32",  // element type: byte (default), int8, bf16, fp32
+//   "abs": 0.0,      // absolute tolerance
+//   "rel": 0.0,      // relative tolerance
+//   "ulp": 0,        // tolerance in units of least precision
+//   "report": 10,    // number of mismatches to report
+//   "threads": 0     // comparison threads, 0 for hardware concurrency
+// }
+//
+// An element passes if it is within any of the tolerances.  Returns
+// an empty string on success, otherwise a mismatch summary.
+static std::string
+buffer(const char* gold, const char* value, size_t size, const json& node)
+{
+  using profile_error = xrt_core::runner::profile_error;
+
+  auto type = node.value<std::string>("type", "byte");
+  tolerance tol {
+    node.value<float>("abs", 0.0f),
+    node.value<float>("rel", 0.0f),
+    node.value<int64_t>("ulp", 0)
+  };
+  auto max_first = node.value<size_t>("report", 10);
+  auto threads = node.value<size_t>("threads", 0);
+
+  auto run = [&](auto element) {
+    using element_type = decltype(element);
+    if (size % sizeof(typename element_type::bits_type))
+      throw profile_error("validate buffer size " + std::to_string(size)
+                          + " is not a multiple of " + type + " element size");
+    auto rpt = compare<element_type>(gold, value, size, tol, max_first, threads);
+    return rpt.mismatches ? to_string(rpt, element_type::name, tol) : std::string{};
+  };
+
+  if (type == "byte") {
+    if (tol.abs != 0.0f || tol.rel != 0.0f || tol.ulp != 0)
+      throw profile_error("validate tolerance requires an element type");
+    return run(bytes{});
+  }
+  if (type == "int8")
+    return run(int8{});
+  if (type == "bf16")
+    return run(bf16{});
+  if (type == "fp32")
+    return run(fp32{});
+
+  throw profile_error("Unsupported validate type: " + type);
+}
+
+} // validate
+
 // class recipe - Runner recipe
 class recipe
 {
@@ -1674,7 +1733,11 @@ class profile
     // "validate": {
     //   "size": 0,   // unused for now
     //   "offset": 0, // unused for now
-    //   "file": "gold.bin"
+    //   "file": "gold.bin",
+    //   "type": "fp32", // optional element type and tolerances,
+    //   "abs": 1e-3,    // see validate::buffer()
+    //   "rel": 1e-2,
+    //   "ulp": 2
     //  }
     void
     validate_buffer(xrt::bo& bo, const validate_node& node, const artifacts::repo* repo)
@@ -1704,16 +1767,9 @@ class profile
       if (bo.size() != golden_data.size())
         throw validation_error("Size mismatch during validation");
 
-      if (std::equal(golden_data.data(), golden_data.data() + golden_data.size(), bo_data))
-        return;
-
-      // Error
-      for (uint64_t i = 0; i < golden_data.size(); ++i) {
-        if (golden_data[i] != bo_data[i])
-          throw validation_error
-            ("gold[" + std::to_string(i) + "] = " + std::to_string(golden_data[i])
-             + " does not match bo value in bo " + std::to_string(bo_data[i]));
-      }
+      auto error = validate::buffer(golden_data.data(), bo_data, golden_data.size(), node);
+      if (!error.empty())
+        throw validation_error("Validation failed, " + error);
     }
 
     // init_buffer_file() - Initialize bo from a content of a file
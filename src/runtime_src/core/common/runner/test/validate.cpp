@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Test of runner buffer validation, no device is required
+//
+// % validate
+//
+// Compares small fp32 and bf16 buffers with tolerances and checks
+// the number of reported mismatches.
+#include "../validate.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace xrt_core::validate;
+
+template <typename Element>
+static void
+expect(const std::string& what, const std::vector<typename Element::bits_type>& gold,
+       const std::vector<typename Element::bits_type>& value, const tolerance& tol, size_t mismatches)
+{
+  auto size = gold.size() * sizeof(typename Element::bits_type);
+  auto rpt = compare<Element>(reinterpret_cast<const char*>(gold.data()),
+                              reinterpret_cast<const char*>(value.data()),
+                              size, tol, 10, 1);
+  if (rpt.mismatches != mismatches)
+    throw std::runtime_error(what + ": expected " + std::to_string(mismatches) + " mismatches, got "
+                             + to_string(rpt, Element::name, tol));
+  std::cout << what << ": ok\n";
+}
+
+static uint32_t
+bits(float f)
+{
+  uint32_t b = 0;
+  std::memcpy(&b, &f, sizeof(b));
+  return b;
+}
+
+static void
+run()
+{
+  constexpr uint32_t qnan = 0x7fc00000;
+  constexpr uint32_t inf = 0x7f800000;
+
+  tolerance ulp2 {0.0f, 0.0f, 2};
+  tolerance loose {1e30f, 1.0f, 1 << 30};
+
+  expect<fp32>("fp32 ulp", {bits(1.0f)}, {bits(1.0f) + 2}, ulp2, 0);
+  expect<fp32>("fp32 ulp exceeded", {bits(1.0f)}, {bits(1.0f) + 3}, ulp2, 1);
+  expect<fp32>("fp32 abs", {bits(1.0f)}, {bits(1.001f)}, {0.01f, 0.0f, 0}, 0);
+
+  // NaN matches only a NaN with identical bits, regardless of tolerance
+  expect<fp32>("fp32 identical nan", {qnan}, {qnan}, loose, 0);
+  expect<fp32>("fp32 nan payload", {qnan}, {qnan + 1}, ulp2, 1);
+  expect<fp32>("fp32 nan vs inf", {inf + 1}, {inf}, ulp2, 1);
+  expect<fp32>("fp32 nan vs value", {qnan}, {bits(1.0f)}, loose, 1);
+  expect<fp32>("fp32 value vs nan", {bits(1.0f)}, {qnan}, loose, 1);
+
+  expect<bf16>("bf16 identical nan", {0x7fc0}, {0x7fc0}, loose, 0);
+  expect<bf16>("bf16 nan payload", {0x7fc0}, {0x7fc1}, ulp2, 1);
+  expect<bf16>("bf16 nan vs inf", {0x7f81}, {0x7f80}, ulp2, 1);
+}
+
+int
+main()
+{
+  try {
+    run();
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cerr << "Error: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cerr << "Unknown error" << "\n";
+  }
+  return 1;
+}
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_COMMON_RUNNER_VALIDATE_H_
+#define XRT_COMMON_RUNNER_VALIDATE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Buffer validation against golden data.
+//
+// Validation compares a buffer element by element with golden data
+// using an element type and tolerances.  The buffer is split into
+// chunks compared in parallel.  Each chunk is processed in blocks,
+// a block is first compared with memcmp, and only blocks that differ
+// are compared per element with a branch free loop that the compiler
+// can vectorize.  Elements are inspected one by one only in blocks
+// that actually have mismatches, to build the report.
+namespace xrt_core::validate {
+
+// Elements compared per block
+constexpr size_t block_elements = 4096;
+
+// Minimum number of bytes worth comparing in a separate thread
+constexpr size_t min_thread_bytes = 4 * 1024 * 1024;
+
+struct tolerance
+{
+  float abs = 0.0f;    // |gold - value| <= abs
+  float rel = 0.0f;    // |gold - value| <= rel * |gold|
+  int64_t ulp = 0;     // distance in units of least precision
+};
+
+struct mismatch
+{
+  size_t index = 0;
+  double gold = 0.0;
+  double value = 0.0;
+  double error = 0.0;
+};
+
+struct report
+{
+  size_t elements = 0;
+  size_t mismatches = 0;
+  std::vector<mismatch> first;  // first mismatches in index order
+  mismatch worst;               // mismatch with largest absolute error
+};
+
+// Element types.  bits_type is the storage of an element, value()
+// converts to float, ordered() maps the bits to an integer such that
+// the difference of two ordered values is the ulp distance.
+struct fp32
+{
+  using bits_type = uint32_t;
+  static constexpr const char* name = "fp32";
+
+  static float
+  value(bits_type b)
+  {
+    float f = 0.0f;
+    std::memcpy(&f, &b, sizeof(f));
+    return f;
+  }
+
+  static int64_t
+  ordered(bits_type b)
+  {
+    auto i = static_cast<int32_t>(b);
+    return i < 0 ? static_cast<int64_t>(std::numeric_limits<int32_t>::min()) - i : i;
+  }
+};
+
+struct bf16
+{
+  using bits_type = uint16_t;
+  static constexpr const char* name = "bf16";
+
+  static float
+  value(bits_type b)
+  {
+    return fp32::value(static_cast<uint32_t>(b) << 16);
+  }
+
+  static int64_t
+  ordered(bits_type b)
+  {
+    auto i = static_cast<int16_t>(b);
+    return i < 0 ? static_cast<int64_t>(std::numeric_limits<int16_t>::min()) - i : i;
+  }
+};
+
+struct int8
+{
+  using bits_type = uint8_t;
+  static constexpr const char* name = "int8";
+
+  static float
+  value(bits_type b)
+  {
+    return static_cast<float>(static_cast<int8_t>(b));
+  }
+
+  static int64_t
+  ordered(bits_type b)
+  {
+    return static_cast<int8_t>(b);
+  }
+};
+
+// Exact byte comparison, no tolerance applies
+struct bytes
+{
+  using bits_type = uint8_t;
+  static constexpr const char* name = "byte";
+
+  static float
+  value(bits_type b)
+  {
+    return static_cast<float>(b);
+  }
+
+  static int64_t
+  ordered(bits_type b)
+  {
+    return b;
+  }
+};
+
+template <typename Element>
+typename Element::bits_type
+load(const char* data, size_t idx)
+{
+  typename Element::bits_type b;
+  std::memcpy(&b, data + idx * sizeof(b), sizeof(b));
+  return b;
+}
+
+template <typename Element>
+bool
+within(typename Element::bits_type gold, typename Element::bits_type value, const tolerance& tol)
+{
+  auto g = Element::value(gold);
+  auto v = Element::value(value);
+  auto err = std::fabs(g - v);
+  auto ulp = std::abs(Element::ordered(gold) - Element::ordered(value));
+  // NaN matches only identical bits.  The tolerances are masked out
+  // for NaN since the ulp distance between NaN and another NaN or an
+  // infinity can be small.
+  auto nan = std::isnan(g) | std::isnan(v);
+  auto close = (err <= tol.abs) | (err <= tol.rel * std::fabs(g)) | (ulp <= tol.ulp);
+  return (gold == value) | ((!nan) & close);
+}
+
+// Count mismatches in a block, no branches in loop body
+template <typename Element>
+size_t
+count_block(const char* gold, const char* value, size_t count, const tolerance& tol)
+{
+  size_t bad = 0;
+  for (size_t i = 0; i < count; ++i)
+    bad += !within<Element>(load<Element>(gold, i), load<Element>(value, i), tol);
+  return bad;
+}
+
+// Record mismatches of a block known to have some
+template <typename Element>
+void
+record_block(const char* gold, const char* value, size_t base, size_t count,
+             const tolerance& tol, size_t max_first, report& rpt)
+{
+  for (size_t i = 0; i < count; ++i) {
+    auto g = load<Element>(gold, i);
+    auto v = load<Element>(value, i);
+    if (within<Element>(g, v, tol))
+      continue;
+
+    mismatch mm {
+      base + i,
+      Element::value(g),
+      Element::value(v),
+      std::fabs(static_cast<double>(Element::value(g)) - Element::value(v))
+    };
+
+    if (rpt.mismatches == 0 || !(mm.error <= rpt.worst.error))
+      rpt.worst = mm;
+    if (rpt.first.size() < max_first)
+      rpt.first.push_back(mm);
+    ++rpt.mismatches;
+  }
+}
+
+// Compare elements [begin, end) of gold and value
+template <typename Element>
+report
+compare_range(const char* gold, const char* value, size_t begin, size_t end,
+              const tolerance& tol, size_t max_first)
+{
+  constexpr auto esz = sizeof(typename Element::bits_type);
+  report rpt;
+  rpt.elements = end - begin;
+  for (size_t blk = begin; blk < end; blk += block_elements) {
+    auto count = std::min(block_elements, end - blk);
+    auto g = gold + blk * esz;
+    auto v = value + blk * esz;
+    if (std::memcmp(g, v, count * esz) == 0)
+      continue;
+    if (count_block<Element>(g, v, count, tol) == 0)
+      continue;
+    record_block<Element>(g, v, blk, count, tol, max_first, rpt);
+  }
+  return rpt;
+}
+
+// Merge chunk reports, which must be in index order
+inline report
+merge(std::vector<report>& reports, size_t max_first)
+{
+  report rpt;
+  for (auto& r : reports) {
+    rpt.elements += r.elements;
+    if (!r.mismatches)
+      continue;
+    if (!rpt.mismatches || !(r.worst.error <= rpt.worst.error))
+      rpt.worst = r.worst;
+    rpt.mismatches += r.mismatches;
+    for (auto& mm : r.first) {
+      if (rpt.first.size() == max_first)
+        break;
+      rpt.first.push_back(mm);
+    }
+  }
+  return rpt;
+}
+
+template <typename Element>
+report
+compare(const char* gold, const char* value, size_t size,
+        const tolerance& tol, size_t max_first, size_t threads)
+{
+  constexpr auto esz = sizeof(typename Element::bits_type);
+  auto elements = size / esz;
+
+  if (!threads)
+    threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  threads = std::max<size_t>(1, std::min(threads, size / min_thread_bytes));
+
+  // Chunk boundaries are block aligned
+  auto blocks = (elements + block_elements - 1) / block_elements;
+  auto chunk = ((blocks + threads - 1) / threads) * block_elements;
+
+  std::vector<report> reports(threads);
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; ++t) {
+    auto begin = std::min(elements, t * chunk);
+    auto end = std::min(elements, begin + chunk);
+    workers.emplace_back([&, t, begin, end] {
+      reports[t] = compare_range<Element>(gold, value, begin, end, tol, max_first);
+    });
+  }
+  reports[0] = compare_range<Element>(gold, value, 0, std::min(elements, chunk), tol, max_first);
+
+  for (auto& w : workers)
+    w.join();
+
+  return merge(reports, max_first);
+}
+
+inline std::string
+to_string(const report& rpt, const char* type, const tolerance& tol)
+{
+  std::ostringstream ostr;
+  ostr.precision(std::numeric_limits<float>::max_digits10);
+  ostr << rpt.mismatches << " of " << rpt.elements << " " << type << " elements mismatch"
+       << " (abs=" << tol.abs << ", rel=" << tol.rel << ", ulp=" << tol.ulp << ")"
+       << ", max error " << rpt.worst.error << " at [" << rpt.worst.index << "]";
+  for (const auto& mm : rpt.first)
+    ostr << "\n  [" << mm.index << "] gold = " << mm.gold << " bo = " << mm.value;
+  if (rpt.first.size() < rpt.mismatches)
+    ostr << "\n  ...";
+  return ostr.str();
+}
+
+} // xrt_core::validate
+
+#endif
@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace xrt_core {
 class hwctx_handle; // forward declaration
@@ -45,6 +46,13 @@ public:
     uint64_t kmhdl;  // kernel mode handle
   };
 
+  // range - range of a buffer
+  struct range
+  {
+    size_t size;
+    size_t offset;
+  };
+
 public:
   virtual ~buffer_handle()
   {}
@@ -69,6 +77,18 @@ public:
   virtual void
   sync(direction, size_t size, size_t offset) = 0;
 
+  // Sync several ranges of a buffer to or from device
+  //
+  // The ranges are sorted by offset and do not overlap.  The
+  // default syncs the ranges one at a time, which is what all
+  // current shims use.
+  virtual void
+  sync_ranges(direction dir, const std::vector<range>& ranges)
+  {
+    for (const auto& r : ranges)
+      sync(dir, r.size, r.offset);
+  }
+
   // Copy size bytes from src buffer at src offset into this
   // buffer at dst offset
   virtual void
@@ -15,6 +15,7 @@
 #include "xrt/xrt_graph.h"
 
 #include <memory>
+#include <vector>
 
 namespace xrt_core {
 
@@ -103,6 +104,16 @@ public:
   virtual void
   exec_buf(buffer_handle* cmd) = 0;
 
+  // Execution of independent command objects when the shim does not
+  // support hardware queues.  Calls exec_buf() for each command,
+  // see hwqueue_handle::submit_commands().
+  virtual void
+  exec_bufs(const std::vector<buffer_handle*>& cmds)
+  {
+    for (auto cmd : cmds)
+      exec_buf(cmd);
+  }
+
   virtual std::unique_ptr<xrt_core::graph_handle>
   open_graph_handle(const char*, xrt::graph::access_mode)
   {
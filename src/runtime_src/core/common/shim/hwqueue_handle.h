@@ -28,6 +28,19 @@ public:
   virtual void
   submit_command(buffer_handle* cmd) = 0;
 
+  // Submit independent commands for execution
+  //
+  // The commands have no ordering or error dependencies between
+  // them.  The default submits the commands one at a time, no shim
+  // currently overrides it since no driver accepts several commands
+  // in one call.
+  virtual void
+  submit_commands(const std::vector<buffer_handle*>& cmds)
+  {
+    for (auto cmd : cmds)
+      submit_command(cmd);
+  }
+
   // Poll for command completion
   //
   // @cmd    Handle to command to poll for
@@ -8,20 +8,123 @@
 
 #include <boost/property_tree/ptree.hpp>
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace {
 
-static std::map<xrt_core::device::id_type, std::weak_ptr<xrt_core::device>> mgmtpf_device_map;
-static std::map<xrt_core::device::handle_type, std::weak_ptr<xrt_core::device>> userpf_device_map;
+// class device_registry - Read optimized map of key to device
+//
+// Lookup of a device from its shim handle is on the hot path of
+// legacy APIs, while insertion happens only when a device is opened.
+//
+// The registry is an immutable sorted snapshot published through an
+// atomic pointer.  Lookups search the current snapshot without any
+// lock.  Insertion copies the current snapshot under a mutex, prunes
+// expired devices, adds the new entry, and publishes the copy.
+//
+// A replaced snapshot is reclaimed once no lookup can be reading it.
+// A lookup registers in the reader count of the current epoch for the
+// duration of the search.  Insertion advances the epoch after
+// publishing the new snapshot and waits for the readers of the
+// previous epoch to finish before deleting the old snapshot, so
+// memory does not grow when a process repeatedly opens and closes
+// devices.
+template <typename KeyType>
+class device_registry
+{
+  using entry = std::pair<KeyType, std::weak_ptr<xrt_core::device>>;
+  using snapshot = std::vector<entry>;
+
+  std::atomic<const snapshot*> m_current {nullptr};
+  std::atomic<unsigned int> m_epoch {0};
+  mutable std::array<std::atomic<unsigned int>, 2> m_readers {};
+  std::mutex m_mutex;  // serialize writers
+
+  static bool
+  less(const entry& e, const KeyType& key)
+  {
+    return e.first < key;
+  }
+
+  // Enter the current epoch, return the reader slot to leave
+  std::atomic<unsigned int>&
+  enter() const
+  {
+    while (true) {
+      auto epoch = m_epoch.load();
+      auto& readers = m_readers[epoch & 1];
+      ++readers;
+      if (m_epoch.load() == epoch)
+        return readers;
+      --readers;  // epoch advanced, retry in new epoch
+    }
+  }
+
+public:
+  device_registry() = default;
+  device_registry(const device_registry&) = delete;
+  device_registry& operator=(const device_registry&) = delete;
+
+  ~device_registry()
+  {
+    delete m_current.load();
+  }
+
+  std::shared_ptr<xrt_core::device>
+  find(const KeyType& key) const
+  {
+    auto& readers = enter();
+    std::shared_ptr<xrt_core::device> device;
+    if (auto snap = m_current.load()) {
+      auto itr = std::lower_bound(snap->begin(), snap->end(), key, less);
+      if (itr != snap->end() && itr->first == key)
+        device = itr->second.lock();
+    }
+    --readers;
+    return device;
+  }
+
+  // Create or replace entry for key
+  void
+  insert(const KeyType& key, const std::shared_ptr<xrt_core::device>& device)
+  {
+    std::lock_guard lk(m_mutex);
+    auto next = std::make_unique<snapshot>();
+    auto prev = m_current.load();
+    if (prev) {
+      next->reserve(prev->size() + 1);
+      std::copy_if(prev->begin(), prev->end(), std::back_inserter(*next),
+                   [&key](const auto& e) { return e.first != key && !e.second.expired(); });
+    }
+
+    next->emplace(std::lower_bound(next->begin(), next->end(), key, less), key, device);
+    m_current.store(next.release());
+
+    // Lookups entering after the epoch advances see the new snapshot,
+    // wait for lookups of the previous epoch before deleting the old
+    auto epoch = m_epoch.fetch_add(1);
+    while (m_readers[epoch & 1].load())
+      std::this_thread::yield();
+
+    delete prev;
+  }
+};
 
-// mutex to protect insertion
-static std::mutex mutex;
+static device_registry<xrt_core::device::id_type> mgmtpf_devices;
+static device_registry<xrt_core::device::handle_type> userpf_devices;
+
+// mutex to serialize construction of mgmtpf devices
+static std::mutex mgmtpf_mutex;
 
 }
 
@@ -122,24 +225,18 @@ get_userpf_device(device::id_type id)
   // The repackage raw ptr is the one that should be cached so
   // so that all references to device handles in application code
   // are tied to the shared ptr that ends up calling xclClose
-  std::lock_guard lk(mutex);
-  userpf_device_map[device->get_device_handle()] = ptr;
+  userpf_devices.insert(device->get_device_handle(), ptr);
   return ptr;
 }
 
 std::shared_ptr<device>
 get_userpf_device(device::handle_type handle)
 {
-  // Look up core device from low level shim handle The handle is
-  // inserted into map as part of calling xclOpen.  Protect against
-  // multiple threads calling xclOpen at the same time, e.g. one
-  // thread could be in process of inserting some handle while this
-  // thread is looking up another handle.
-  std::lock_guard lk(mutex);
-  auto itr = userpf_device_map.find(handle);
-  if (itr != userpf_device_map.end())
-    return (*itr).second.lock();
-  return nullptr;
+  // Look up core device from low level shim handle. The handle is
+  // inserted into registry as part of calling xclOpen.  The lookup
+  // is lock free, a concurrent xclOpen in another thread publishes
+  // a new snapshot of the registry.
+  return userpf_devices.find(handle);
 }
 
 std::shared_ptr<device>
@@ -154,8 +251,7 @@ get_userpf_device(device::handle_type handle, device::id_type id)
 
   // Construct a new device object and insert in map.
   auto device = instance().get_userpf_device(handle,id);
-  std::lock_guard lk(mutex);
-  userpf_device_map[handle] = device;  // create or replace
+  userpf_devices.insert(handle, device);  // create or replace
   return device;
 }
 
@@ -163,15 +259,17 @@ std::shared_ptr<device>
 get_mgmtpf_device(device::id_type id)
 {
   // Check cache
-  std::lock_guard lk(mutex);
-  auto itr = mgmtpf_device_map.find(id);
-  if (itr != mgmtpf_device_map.end())
-    if (auto device = (*itr).second.lock())
-      return device;
+  if (auto device = mgmtpf_devices.find(id))
+    return device;
+
+  // Construct a new device object and insert in registry, check
+  // again under lock in case another thread constructed the device
+  std::lock_guard lk(mgmtpf_mutex);
+  if (auto device = mgmtpf_devices.find(id))
+    return device;
 
-  // Construct a new device object and insert in map
   auto device = instance().get_mgmtpf_device(id);
-  mgmtpf_device_map[id] = device;
+  mgmtpf_devices.insert(id, device);
   return device;
 }
 
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark for lookup of core device from shim handle
+//
+// % cmake -B build -DXILINX_XRT=<path>
+// % cmake --build build --config <Release|Debug>
+//
+// Lookups from 1, 2, 4, and 8 threads on device 0
+// % <path>/device_lookup -t 1,2,4,8 -i 1000000
+//
+// Same while another thread repeatedly opens and closes a device
+// % XCL_EMULATION_MODE=noop <path>/device_lookup -t 8 -o
+//
+// The benchmark measures xrt_core::get_userpf_device(handle), which
+// legacy shim level APIs call to map an xclDeviceHandle to its core
+// device.  With -o the lookups run concurrently with insertion of
+// newly opened devices into the registry.
+
+#include "core/common/device.h"
+#include "core/common/system.h"
+#include "xrt/xrt_device.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: device_lookup [options]\n"
+            << " [-t <threads>] comma separated list of thread counts (default 1,2,4,8)\n"
+            << " [-i <iterations>] lookups per thread (default 1000000)\n"
+            << " [-d <device>] device index (default 0)\n"
+            << " [-o] open and close device in background during lookups\n";
+}
+
+static std::vector<size_t>
+parse_threads(const std::string& arg)
+{
+  std::vector<size_t> threads;
+  std::istringstream is(arg);
+  std::string tok;
+  while (std::getline(is, tok, ','))
+    threads.push_back(std::stoul(tok));
+  for (auto t : threads)
+    if (t == 0)
+      throw std::runtime_error("Invalid thread list: " + arg);
+  return threads;
+}
+
+// Lookups per second across all threads
+static double
+bench_lookup(xrt_core::device::handle_type handle, size_t threads, size_t iterations)
+{
+  std::atomic<size_t> misses{0};
+  auto worker = [&] {
+    for (size_t i = 0; i < iterations; ++i)
+      if (!xrt_core::get_userpf_device(handle))
+        ++misses;
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t)
+    workers.emplace_back(worker);
+  for (auto& w : workers)
+    w.join();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (misses)
+    throw std::runtime_error("device lookup failed " + std::to_string(misses) + " times");
+
+  return threads * iterations / std::chrono::duration<double>(end - start).count();
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  std::vector<size_t> threads {1, 2, 4, 8};
+  size_t iterations = 1000000;  // NOLINT
+  unsigned int device_index = 0;
+  bool churn = false;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg == "-o") {
+      churn = true;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-t")
+      threads = parse_threads(arg);
+    else if (cur == "-i")
+      iterations = std::stoul(arg);
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  xrt::device device{device_index};
+  auto handle = device.get_handle()->get_device_handle();
+
+  // Optionally open and close devices while lookups are running,
+  // each open inserts a new device into the registry
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> opens{0};
+  std::thread opener;
+  if (churn)
+    opener = std::thread([&] {
+      while (!stop) {
+        xrt::device d{device_index};
+        ++opens;
+      }
+    });
+
+  for (auto t : threads)
+    std::cout << "threads " << t << ": " << static_cast<uint64_t>(bench_lookup(handle, t, iterations))
+              << " lookups/s\n";
+
+  if (churn) {
+    stop = true;
+    opener.join();
+    std::cout << "device opens during lookups: " << opens << '\n';
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
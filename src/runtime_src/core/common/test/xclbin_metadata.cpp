@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Startup benchmark for xclbin kernel metadata
+//
+// % cmake -B build -DXILINX_XRT=<path>
+// % cmake --build build --config <Release|Debug>
+//
+// Synthesized xml meta data with 128 kernels of 32 arguments each
+// % <path>/xclbin_metadata -k 128 -a 32
+//
+// Time to create all kernels of an xclbin on device 0
+// % <path>/xclbin_metadata -x my.xclbin -d 0
+//
+// Cold start with persistent metadata cache, the first run populates
+// the cache, subsequent runs load the metadata from the cache
+// % cat xrt.ini
+// [Runtime]
+// xclbin_metadata_cache=/tmp/xrt_metadata
+// % <path>/xclbin_metadata -k 128 -a 32 -u 01234567-89ab-cdef-0123-456789abcdef
+//
+// The synthesized benchmark measures what xrt::xclbin does when it
+// collects kernel meta data: get_kernels() followed by
+// get_kernel_properties() for each kernel.  The xclbin benchmark
+// measures time from loading the xclbin until all its kernels have
+// been created, which is the metadata part of time to first run.
+
+#include "core/common/xclbin_parser.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_xclbin.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: xclbin_metadata [options]\n"
+            << " [-k <kernels>] number of kernels in synthesized xml (default 64)\n"
+            << " [-a <args>] number of arguments per kernel in synthesized xml (default 32)\n"
+            << " [-i <iterations>] number of times to repeat the measurement (default 3)\n"
+            << " [-u <uuid>] uuid of synthesized xml for persistent metadata cache\n"
+            << " [-x <xclbin>] measure kernel creation from xclbin\n"
+            << " [-d <device>] device index used with -x (default 0)\n";
+}
+
+static std::string
+synthesize_xml(size_t kernels, size_t args)
+{
+  std::ostringstream xml;
+  xml << "<project name=\"bench\"><platform><device fpgaDevice=\"bench\"><core>";
+  for (size_t k = 0; k < kernels; ++k) {
+    xml << "<kernel name=\"kernel_" << k << "\" language=\"c\" type=\"pl\">"
+        << "<port name=\"M_AXI_GMEM\" mode=\"master\" range=\"0xFFFFFFFF\" dataWidth=\"512\"/>"
+        << "<port name=\"S_AXI_CONTROL\" mode=\"slave\" range=\"0x1000\" dataWidth=\"32\"/>";
+    for (size_t a = 0; a < args; ++a) {
+      xml << "<arg name=\"arg_" << a << "\" addressQualifier=\"1\" id=\"" << a << "\""
+          << " port=\"M_AXI_GMEM\" size=\"0x8\" offset=\"0x" << std::hex << (0x10 + a * 8) << std::dec << "\""
+          << " hostOffset=\"0x0\" hostSize=\"0x8\" type=\"int*\"/>";
+    }
+    xml << "<instance name=\"kernel_" << k << "_1\">"
+        << "<addrRemap base=\"0x" << std::hex << (0x10000 * k) << std::dec << "\" range=\"0x10000\" port=\"S_AXI_CONTROL\"/>"
+        << "</instance></kernel>";
+  }
+  xml << "</core></device></platform></project>";
+  return xml.str();
+}
+
+static double
+bench_xml(const std::string& xml, const std::string& uuid)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  if (!uuid.empty())
+    xrt_core::xclbin::load_xml_metadata(xml.data(), xml.size(), xrt::uuid{uuid});
+  auto kernels = xrt_core::xclbin::get_kernels(xml.data(), xml.size());
+  for (const auto& kernel : kernels)
+    xrt_core::xclbin::get_kernel_properties(xml.data(), xml.size(), kernel.name);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static double
+bench_xclbin(const std::string& xclbin_fnm, unsigned int device_index)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  xrt::device device{device_index};
+  xrt::xclbin xclbin{xclbin_fnm};
+  auto uuid = device.register_xclbin(xclbin);
+  xrt::hw_context hwctx{device, uuid};
+  std::vector<xrt::kernel> kernels;
+  for (const auto& kernel : xclbin.get_kernels())
+    kernels.emplace_back(hwctx, kernel.get_name());
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "created " << kernels.size() << " kernels, ";
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  std::string xclbin_fnm;
+  std::string uuid;
+  unsigned int device_index = 0;
+  size_t kernels = 64;   // NOLINT
+  size_t kargs = 32;     // NOLINT
+  size_t iterations = 3;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      kernels = std::stoul(arg);
+    else if (cur == "-a")
+      kargs = std::stoul(arg);
+    else if (cur == "-i")
+      iterations = std::stoul(arg);
+    else if (cur == "-u")
+      uuid = arg;
+    else if (cur == "-x")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (!xclbin_fnm.empty()) {
+    for (size_t i = 0; i < iterations; ++i)
+      std::cout << "iteration " << i << ": " << bench_xclbin(xclbin_fnm, device_index) << "ms\n";
+    return;
+  }
+
+  // First iteration parses the xml, subsequent iterations show the
+  // cost of metadata lookup for already parsed xml
+  auto xml = synthesize_xml(kernels, kargs);
+  std::cout << "xml: " << xml.size() << " bytes, " << kernels << " kernels, " << kargs << " args\n";
+  for (size_t i = 0; i < iterations; ++i)
+    std::cout << "iteration " << i << ": " << bench_xml(xml, uuid) << "ms\n";
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
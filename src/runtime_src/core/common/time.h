@@ -5,6 +5,7 @@
 #define xrtcore_util_time_h_
 
 #include "core/common/config.h"
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -27,6 +28,13 @@ XRT_CORE_COMMON_EXPORT
 std::string
 timestamp();
 
+/**
+ * @return formatted timestamp for time point
+ */
+XRT_CORE_COMMON_EXPORT
+std::string
+timestamp(std::chrono::system_clock::time_point time);
+
 /**
  * @return timestamp for epoch
  */
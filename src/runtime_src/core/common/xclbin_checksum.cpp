@@ -0,0 +1,407 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "core/common/xclbin_checksum.h"
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+
+#include "core/include/xrt/xrt_uuid.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+# include <nmmintrin.h>
+# define XRT_CRC32C_SSE42
+#endif
+
+#ifdef _WIN32
+# include <process.h>
+#else
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace sfs = std::filesystem;
+
+namespace {
+
+using namespace xrt_core::xclbin::checksum;
+
+// Size of blocks hashed by separate threads
+constexpr size_t block_size = 4 * 1024 * 1024;
+
+// Bump version when format of persisted checksums changes
+constexpr char magic[] = "XRTXSUM";
+constexpr unsigned int version = 2;
+
+////////////////////////////////////////////////////////////////
+// CRC32C, reflected polynomial 0x82f63b78
+////////////////////////////////////////////////////////////////
+static std::array<uint32_t, 256>
+make_crc_table()
+{
+  std::array<uint32_t, 256> table {};
+  for (uint32_t idx = 0; idx < 256; ++idx) {
+    uint32_t crc = idx;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+    table[idx] = crc;
+  }
+  return table;
+}
+
+static uint32_t
+crc32c_sw(const uint8_t* data, size_t size, uint32_t crc)
+{
+  static const auto table = make_crc_table();
+  for (; size; ++data, --size)
+    crc = table[(crc ^ *data) & 0xff] ^ (crc >> 8);
+  return crc;
+}
+
+#ifdef XRT_CRC32C_SSE42
+__attribute__((target("sse4.2")))
+static uint32_t
+crc32c_hw(const uint8_t* data, size_t size, uint32_t crc)
+{
+  uint64_t crc64 = crc;
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+
+  crc = static_cast<uint32_t>(crc64);
+  for (; size; ++data, --size)
+    crc = _mm_crc32_u8(crc, *data);
+  return crc;
+}
+
+static bool
+has_sse42()
+{
+  static bool value = __builtin_cpu_supports("sse4.2");
+  return value;
+}
+#endif
+
+////////////////////////////////////////////////////////////////
+// Validation records
+////////////////////////////////////////////////////////////////
+
+// struct file_key - Identity of a file on disk
+struct file_key
+{
+  uint64_t dev = 0;
+  uint64_t ino = 0;
+  uint64_t size = 0;
+  int64_t mtime = 0;
+
+  bool
+  operator==(const file_key& rhs) const
+  {
+    return dev == rhs.dev && ino == rhs.ino && size == rhs.size && mtime == rhs.mtime;
+  }
+};
+
+// struct record - Checksums of an xclbin file when last validated
+struct record
+{
+  file_key key;
+  std::vector<section> sections;
+};
+
+static std::optional<file_key>
+get_file_key(const std::string& path)
+{
+  file_key key;
+#ifdef _WIN32
+  std::error_code ec;
+  key.size = sfs::file_size(path, ec);
+  if (ec)
+    return std::nullopt;
+  key.mtime = sfs::last_write_time(path, ec).time_since_epoch().count();
+  if (ec)
+    return std::nullopt;
+#else
+  struct stat st {};
+  if (::stat(path.c_str(), &st))
+    return std::nullopt;
+  key.dev = st.st_dev;
+  key.ino = st.st_ino;
+  key.size = st.st_size;
+  key.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+  return key;
+}
+
+// Records are kept per xclbin uuid and file, such that different
+// files with the same uuid do not share reference checksums.  A file
+// is identified by device and inode, or by its absolute path where
+// there are no inodes.
+static std::string
+get_record_id(const std::string& uuid, const std::string& path, const file_key& key)
+{
+#ifdef _WIN32
+  std::error_code ec;
+  auto abs = sfs::absolute(path, ec);
+  auto file = std::hash<std::string>{}(ec ? path : abs.string());
+  return uuid + "." + std::to_string(file);
+#else
+  (void)path;
+  return uuid + "." + std::to_string(key.dev) + "." + std::to_string(key.ino);
+#endif
+}
+
+static sfs::path
+get_record_file(const std::string& id)
+{
+  return sfs::path(xrt_core::config::get_xclbin_validate_cache()) / (id + ".xsum");
+}
+
+// Persisted record, a text file with file key followed by one line
+// per section
+static std::optional<record>
+load_record(const std::string& id)
+{
+  if (xrt_core::config::get_xclbin_validate_cache().empty())
+    return std::nullopt;
+
+  std::ifstream ifs(get_record_file(id));
+  if (!ifs)
+    return std::nullopt;
+
+  std::string m;
+  unsigned int v = 0;
+  size_t count = 0;
+  record rec;
+  ifs >> m >> v >> rec.key.dev >> rec.key.ino >> rec.key.size >> rec.key.mtime >> count;
+  if (!ifs || m != magic || v != version)
+    return std::nullopt;
+
+  for (; count; --count) {
+    section s {};
+    if (!(ifs >> s.kind >> s.offset >> s.size >> s.crc))
+      return std::nullopt;
+    rec.sections.push_back(s);
+  }
+
+  return rec;
+}
+
+static void
+store_record(const std::string& id, const record& rec)
+{
+  if (xrt_core::config::get_xclbin_validate_cache().empty())
+    return;
+
+  // Write to a process unique file and rename it into place, such
+  // that concurrent readers never see a partially written file
+  auto path = get_record_file(id);
+#ifdef _WIN32
+  auto pid = _getpid();
+#else
+  auto pid = getpid();
+#endif
+  auto tmp = path;
+  tmp += "." + std::to_string(pid);
+
+  std::error_code ec;
+  sfs::create_directories(path.parent_path(), ec);
+  {
+    std::ofstream ofs(tmp, std::ios::trunc);
+    if (!ofs)
+      return;
+    ofs << magic << ' ' << version << '\n'
+        << rec.key.dev << ' ' << rec.key.ino << ' ' << rec.key.size << ' ' << rec.key.mtime << '\n'
+        << rec.sections.size() << '\n';
+    for (const auto& s : rec.sections)
+      ofs << s.kind << ' ' << s.offset << ' ' << s.size << ' ' << s.crc << '\n';
+    if (!ofs) {
+      ofs.close();
+      sfs::remove(tmp, ec);
+      return;
+    }
+  }
+  sfs::rename(tmp, path, ec);
+  if (ec)
+    sfs::remove(tmp, ec);
+}
+
+// In process records by record id
+static std::mutex s_mutex;
+static std::map<std::string, record> s_records;
+
+[[noreturn]] static void
+invalid(const std::string& path, const std::string& msg)
+{
+  throw std::runtime_error("Invalid xclbin '" + path + "': " + msg);
+}
+
+} // namespace
+
+namespace xrt_core::xclbin::checksum {
+
+bool
+enabled()
+{
+  static bool value = xrt_core::config::get_xclbin_validate();
+  return value;
+}
+
+uint32_t
+crc32c(const void* data, size_t size, uint32_t crc)
+{
+  auto bytes = static_cast<const uint8_t*>(data);
+#ifdef XRT_CRC32C_SSE42
+  if (has_sse42())
+    return ~crc32c_hw(bytes, size, ~crc);
+#endif
+  return ~crc32c_sw(bytes, size, ~crc);
+}
+
+std::vector<section>
+compute(const axlf* top)
+{
+  struct block
+  {
+    const char* data;
+    size_t size;
+  };
+
+  // Split sections into blocks, such that a large bitstream is
+  // hashed by all threads
+  auto base = reinterpret_cast<const char*>(top);
+  std::vector<section> sections;
+  std::vector<size_t> first;  // index of first block of each section
+  std::vector<block> blocks;
+  for (uint32_t idx = 0; idx < top->m_header.m_numSections; ++idx) {
+    const auto& hdr = top->m_sections[idx];
+    sections.push_back({hdr.m_sectionKind, hdr.m_sectionOffset, hdr.m_sectionSize, 0});
+    first.push_back(blocks.size());
+    for (uint64_t offset = 0; offset < hdr.m_sectionSize; offset += block_size)
+      blocks.push_back({base + hdr.m_sectionOffset + offset,
+                        static_cast<size_t>(std::min<uint64_t>(block_size, hdr.m_sectionSize - offset))});
+  }
+  first.push_back(blocks.size());
+
+  std::vector<uint32_t> crcs(blocks.size());
+  std::atomic<size_t> next {0};
+  auto worker = [&] {
+    for (size_t idx = next++; idx < blocks.size(); idx = next++)
+      crcs[idx] = crc32c(blocks[idx].data, blocks[idx].size);
+  };
+
+  auto nthreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), blocks.size());
+  std::vector<std::thread> threads;
+  try {
+    for (size_t idx = 1; idx < nthreads; ++idx)
+      threads.emplace_back(worker);
+  }
+  catch (const std::system_error&) {
+    // hash with the threads created so far
+  }
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+
+  for (size_t idx = 0; idx < sections.size(); ++idx)
+    sections[idx].crc = crc32c(crcs.data() + first[idx], (first[idx + 1] - first[idx]) * sizeof(uint32_t));
+
+  return sections;
+}
+
+void
+validate_headers(const axlf* top, size_t file_size)
+{
+  auto length = top->m_header.m_length;
+  if (length > file_size)
+    throw std::runtime_error("xclbin length " + std::to_string(length)
+                             + " exceeds file size " + std::to_string(file_size));
+
+  for (uint32_t idx = 0; idx < top->m_header.m_numSections; ++idx) {
+    const auto& hdr = top->m_sections[idx];
+    if (hdr.m_sectionOffset > length || hdr.m_sectionSize > length - hdr.m_sectionOffset)
+      throw std::runtime_error("section " + std::to_string(idx) + " (kind "
+                               + std::to_string(hdr.m_sectionKind) + ") exceeds xclbin length");
+  }
+}
+
+void
+validate(const std::string& path, const axlf* top, size_t size)
+{
+  if (size < sizeof(axlf) || std::strncmp(top->m_magic, "xclbin2", std::strlen("xclbin2")) != 0)
+    invalid(path, "bad header");
+
+  auto num_sections = top->m_header.m_numSections;
+  if (num_sections > XCLBIN_MAX_NUM_SECTION
+      || sizeof(axlf) + (std::max<size_t>(num_sections, 1) - 1) * sizeof(axlf_section_header) > size)
+    invalid(path, "bad section headers");
+
+  try {
+    validate_headers(top, size);
+  }
+  catch (const std::exception& ex) {
+    invalid(path, ex.what());
+  }
+
+  // Without a file identity there is no reference to validate the
+  // section checksums against
+  auto key = get_file_key(path);
+  if (!key)
+    return;
+
+  auto uuid = xrt::uuid(top->m_header.uuid).to_string();
+  auto id = get_record_id(uuid, path, *key);
+
+  std::optional<record> previous;
+  {
+    std::lock_guard lk(s_mutex);
+    if (auto itr = s_records.find(id); itr != s_records.end())
+      previous = (*itr).second;
+  }
+  if (!previous)
+    previous = load_record(id);
+
+  // Sections are hashed on every load, the recorded checksums are
+  // only the reference to compare against.  An unchanged file is
+  // rehashed since its content can be corrupted in place without a
+  // change to its size or modification time.
+  auto sections = compute(top);
+  if (previous && previous->sections.size() != sections.size())
+    invalid(path, "sections differ from previous validation of xclbin with uuid " + uuid);
+
+  if (previous) {
+    auto mismatch = std::mismatch(sections.begin(), sections.end(), previous->sections.begin());
+    if (mismatch.first != sections.end())
+      invalid(path, "checksum of section " + std::to_string(std::distance(sections.begin(), mismatch.first))
+              + " (kind " + std::to_string((*mismatch.first).kind)
+              + ") differs from previous validation of xclbin with uuid " + uuid);
+  }
+
+  xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                          "Validated " + std::to_string(sections.size()) + " sections of xclbin '" + path + "'");
+
+  // Reference is unchanged
+  if (previous && previous->key == *key)
+    return;
+
+  record rec {*key, std::move(sections)};
+  store_record(id, rec);
+  std::lock_guard lk(s_mutex);
+  s_records[id] = std::move(rec);
+}
+
+} // xrt_core::xclbin::checksum
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_COMMON_XCLBIN_CHECKSUM_H
+#define XRT_CORE_COMMON_XCLBIN_CHECKSUM_H
+
+#include "core/include/xrt/detail/xclbin.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Integrity validation of xclbin files on load
+//
+// Enabled by xrt.ini Runtime.xclbin_validate.  The axlf header and
+// section headers are checked for consistency, and a CRC32C checksum
+// of every section is computed by a pool of threads.
+//
+// The xclbin format carries no checksums, so validation of section
+// content is trust-on-first-use: the checksums computed the first
+// time a file is validated are the reference for later validations
+// of the same file.  Corruption present when a file is first
+// validated is not detected, nor is corruption of a copy of a file,
+// which is validated as a new file.  References are recorded per
+// xclbin uuid and file identity (device and inode, or absolute path
+// on Windows), so different files with the same uuid are validated
+// independently.  A file is corrupt if any section checksum differs
+// from its reference, whether or not the file appears modified.
+//
+// Sections are hashed on every load.  References are kept in
+// process, and persisted in the directory specified by
+// Runtime.xclbin_validate_cache if set, such that they survive the
+// process.
+namespace xrt_core::xclbin::checksum {
+
+// struct section - Checksum of one section
+//
+// Sections are hashed in blocks by separate threads, the checksum
+// of a section is the CRC32C of its block checksums.
+struct section
+{
+  uint32_t kind;
+  uint64_t offset;
+  uint64_t size;
+  uint32_t crc;
+
+  bool
+  operator==(const section& rhs) const
+  {
+    return kind == rhs.kind && offset == rhs.offset && size == rhs.size && crc == rhs.crc;
+  }
+};
+
+// enabled() - Check if validation is enabled in xrt.ini
+bool
+enabled();
+
+// crc32c() - CRC32C (Castagnoli) of data
+//
+// Uses SSE4.2 crc32 instructions when supported by the cpu.  Pass
+// a previous result as @crc to continue a checksum.
+uint32_t
+crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+// compute() - Compute checksum of each section in parallel
+//
+// @top must reference the complete xclbin.
+std::vector<section>
+compute(const axlf* top);
+
+// validate_headers() - Validate section headers against file size
+//
+// @top must reference the axlf header and all section headers.
+// Throws std::runtime_error if a section is out of bounds.
+void
+validate_headers(const axlf* top, size_t file_size);
+
+// validate() - Validate xclbin read from file
+//
+// @path is the file the complete xclbin @top of @size bytes was read
+// from.  Throws std::runtime_error if the xclbin is invalid.
+void
+validate(const std::string& path, const axlf* top, size_t size);
+
+} // xrt_core::xclbin::checksum
+
+#endif
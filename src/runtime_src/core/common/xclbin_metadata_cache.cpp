@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "core/common/xclbin_metadata_cache.h"
+#include "core/common/config_reader.h"
+#include "core/common/xclbin_checksum.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+# include <process.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace sfs = std::filesystem;
+
+namespace {
+
+using namespace xrt_core::xclbin;
+
+// Bump version when layout of cached meta data changes
+constexpr char magic[] = "XRTXMETA";
+constexpr uint64_t version = 2;
+
+static sfs::path
+get_cache_file(const xrt::uuid& uuid)
+{
+  return sfs::path(xrt_core::config::get_xclbin_metadata_cache()) / (uuid.to_string() + ".xmeta");
+}
+
+// Cache files written by another user are not trusted.  A cache file
+// must be a regular file in a directory, both owned by the current
+// user.  Ownership is not checked on Windows.
+#ifndef _WIN32
+static bool
+is_user_owned(const struct stat& st)
+{
+  return st.st_uid == ::geteuid();
+}
+
+static bool
+is_user_directory(const sfs::path& dir)
+{
+  struct stat st {};
+  return ::stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode) && is_user_owned(st);
+}
+#else
+static bool
+is_user_directory(const sfs::path&)
+{
+  return true;
+}
+#endif
+
+// Checksum of xml, a cache file is used only for identical xml
+static uint64_t
+xml_checksum(std::string_view xml)
+{
+  return xrt_core::xclbin::checksum::crc32c(xml.data(), xml.size());
+}
+
+// class mapped_file - Read-only mapping of a cache file
+class mapped_file
+{
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  std::vector<char> m_buffer;
+#endif
+
+public:
+  explicit
+  mapped_file(const sfs::path& path)
+  {
+#ifdef _WIN32
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs)
+      return;
+    m_buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && is_user_owned(st) && st.st_size > 0) {
+      auto addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        m_data = static_cast<const char*>(addr);
+        m_size = st.st_size;
+      }
+    }
+    ::close(fd);
+#endif
+  }
+
+  ~mapped_file()
+  {
+#ifndef _WIN32
+    if (m_data)
+      ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const char*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+// class writer - Flatten meta data into a byte buffer
+class writer
+{
+  std::string m_buf;
+
+public:
+  void
+  put(uint64_t value)
+  {
+    m_buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void
+  put(const std::string& str)
+  {
+    put(str.size());
+    m_buf.append(str);
+  }
+
+  void
+  put(const kernel_argument& arg)
+  {
+    put(arg.name);
+    put(arg.hosttype);
+    put(arg.port);
+    put(arg.port_width);
+    put(arg.index);
+    put(arg.offset);
+    put(arg.size);
+    put(arg.hostsize);
+    put(arg.fa_desc_offset);
+    put(static_cast<uint64_t>(arg.type));
+    put(static_cast<uint64_t>(arg.dir));
+  }
+
+  void
+  put(const kernel_properties& props)
+  {
+    put(props.name);
+    put(static_cast<uint64_t>(props.type));
+    put(props.counted_auto_restart);
+    put(static_cast<uint64_t>(props.mailbox));
+    put(props.address_range);
+    put(static_cast<uint64_t>(props.sw_reset));
+    put(props.functional);
+    put(props.kernel_id);
+    put(props.workgroupsize);
+    for (auto v : props.compileworkgroupsize)
+      put(v);
+    for (auto v : props.maxworkgroupsize)
+      put(v);
+    put(props.stringtable.size());
+    for (const auto& [id, value] : props.stringtable) {
+      put(id);
+      put(value);
+    }
+  }
+
+  const std::string&
+  buffer() const
+  {
+    return m_buf;
+  }
+};
+
+// class reader - Extract meta data from a mapped cache file
+//
+// Throws if data is exhausted, which means the file is corrupt
+class reader
+{
+  const char* m_itr;
+  const char* m_end;
+
+  void
+  check(size_t size) const
+  {
+    if (static_cast<size_t>(m_end - m_itr) < size)
+      throw std::runtime_error("truncated xclbin metadata cache file");
+  }
+
+public:
+  reader(const char* data, size_t size)
+    : m_itr(data), m_end(data + size)
+  {}
+
+  uint64_t
+  get_u64()
+  {
+    uint64_t value = 0;
+    check(sizeof(value));
+    std::memcpy(&value, m_itr, sizeof(value));
+    m_itr += sizeof(value);
+    return value;
+  }
+
+  size_t
+  get_size()
+  {
+    return static_cast<size_t>(get_u64());
+  }
+
+  std::string
+  get_string()
+  {
+    auto size = get_size();
+    check(size);
+    std::string str(m_itr, size);
+    m_itr += size;
+    return str;
+  }
+
+  kernel_argument
+  get_argument()
+  {
+    kernel_argument arg;
+    arg.name = get_string();
+    arg.hosttype = get_string();
+    arg.port = get_string();
+    arg.port_width = get_size();
+    arg.index = get_size();
+    arg.offset = get_size();
+    arg.size = get_size();
+    arg.hostsize = get_size();
+    arg.fa_desc_offset = get_size();
+    arg.type = static_cast<kernel_argument::argtype>(get_u64());
+    arg.dir = static_cast<kernel_argument::direction>(get_u64());
+    return arg;
+  }
+
+  kernel_properties
+  get_properties()
+  {
+    kernel_properties props;
+    props.name = get_string();
+    props.type = static_cast<kernel_properties::kernel_type>(get_u64());
+    props.counted_auto_restart = get_size();
+    props.mailbox = static_cast<kernel_properties::mailbox_type>(get_u64());
+    props.address_range = get_size();
+    props.sw_reset = get_u64() != 0;
+    props.functional = get_size();
+    props.kernel_id = get_size();
+    props.workgroupsize = get_size();
+    for (auto& v : props.compileworkgroupsize)
+      v = get_size();
+    for (auto& v : props.maxworkgroupsize)
+      v = get_size();
+    for (auto count = get_size(); count; --count) {
+      auto id = static_cast<uint32_t>(get_u64());
+      props.stringtable.emplace(id, get_string());
+    }
+    return props;
+  }
+
+  bool
+  done() const
+  {
+    return m_itr == m_end;
+  }
+};
+
+} // namespace
+
+namespace xrt_core::xclbin::metadata_cache {
+
+bool
+enabled()
+{
+  static bool value = !xrt_core::config::get_xclbin_metadata_cache().empty();
+  return value;
+}
+
+std::optional<metadata>
+load(const xrt::uuid& uuid, std::string_view xml)
+{
+  auto path = get_cache_file(uuid);
+  if (!is_user_directory(path.parent_path()))
+    return std::nullopt;
+
+  mapped_file file(path);
+  if (!file.data())
+    return std::nullopt;
+
+  try {
+    reader rd(file.data(), file.size());
+    if (rd.get_string() != magic || rd.get_u64() != version)
+      return std::nullopt;
+
+    // Invalidate on uuid or xml mismatch
+    if (rd.get_string() != uuid.to_string() || rd.get_size() != xml.size()
+        || rd.get_u64() != xml_checksum(xml))
+      return std::nullopt;
+
+    metadata md;
+    md.project_name = rd.get_string();
+    md.fpga_device_name = rd.get_string();
+    for (auto count = rd.get_size(); count; --count)
+      md.kernel_names.push_back(rd.get_string());
+    for (auto count = rd.get_size(); count; --count) {
+      auto kname = rd.get_string();
+      auto& args = md.args[kname];
+      for (auto nargs = rd.get_size(); nargs; --nargs)
+        args.push_back(rd.get_argument());
+      md.properties.emplace(std::move(kname), rd.get_properties());
+    }
+
+    if (!rd.done())
+      return std::nullopt;
+
+    return md;
+  }
+  catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+void
+store(const xrt::uuid& uuid, std::string_view xml, const metadata& md)
+{
+  writer wr;
+  wr.put(std::string(magic));
+  wr.put(version);
+  wr.put(uuid.to_string());
+  wr.put(xml.size());
+  wr.put(xml_checksum(xml));
+  wr.put(md.project_name);
+  wr.put(md.fpga_device_name);
+  wr.put(md.kernel_names.size());
+  for (const auto& kname : md.kernel_names)
+    wr.put(kname);
+  wr.put(md.properties.size());
+  for (const auto& [kname, props] : md.properties) {
+    wr.put(kname);
+    auto itr = md.args.find(kname);
+    wr.put(itr != md.args.end() ? (*itr).second.size() : 0);
+    if (itr != md.args.end())
+      for (const auto& arg : (*itr).second)
+        wr.put(arg);
+    wr.put(props);
+  }
+
+  // Write to a process unique file and rename it into place, such
+  // that concurrent readers never see a partially written file
+  auto path = get_cache_file(uuid);
+#ifdef _WIN32
+  auto pid = _getpid();
+#else
+  auto pid = getpid();
+#endif
+  auto tmp = path;
+  tmp += "." + std::to_string(pid);
+
+  std::error_code ec;
+  if (sfs::create_directories(path.parent_path(), ec))
+    sfs::permissions(path.parent_path(), sfs::perms::owner_all, ec);
+  if (!is_user_directory(path.parent_path()))
+    return;
+
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      return;
+    const auto& buf = wr.buffer();
+    ofs.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+    if (!ofs) {
+      ofs.close();
+      sfs::remove(tmp, ec);
+      return;
+    }
+  }
+  sfs::rename(tmp, path, ec);
+  if (ec)
+    sfs::remove(tmp, ec);
+}
+
+} // xrt_core::xclbin::metadata_cache
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_COMMON_XCLBIN_METADATA_CACHE_H
+#define XRT_CORE_COMMON_XCLBIN_METADATA_CACHE_H
+
+#include "core/common/xclbin_parser.h"
+#include "core/include/xrt/xrt_uuid.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Persistent cache of kernel meta data extracted from xclbin xml
+//
+// The meta data is flattened into a file named by the xclbin uuid in
+// the directory specified by xrt.ini Runtime.xclbin_metadata_cache.
+// Other processes loading the same xclbin map the file read-only
+// instead of parsing the xml.  A cache file is used only if its uuid,
+// xml size, and xml checksum match the xclbin, otherwise it is
+// rewritten.  Cache files and the cache directory must be owned by
+// the current user, files written by other users are ignored.
+//
+// The cache is best effort, failure to read or write a cache file
+// falls back to parsing the xml.
+namespace xrt_core::xclbin::metadata_cache {
+
+// struct metadata - Meta data extracted from EMBEDDED_METADATA
+//
+// Kernel properties are as specified in the xml without xrt.ini
+// overrides, these are applied by the user of the cache.
+struct metadata
+{
+  std::string project_name;
+  std::string fpga_device_name;
+  std::vector<std::string> kernel_names;
+  std::map<std::string, std::vector<kernel_argument>> args;
+  std::map<std::string, kernel_properties> properties;
+};
+
+// enabled() - Check if cache directory is specified in xrt.ini
+bool
+enabled();
+
+// load() - Load cached meta data for xclbin
+//
+// Return: Meta data, or empty if not cached or if the cache file is
+// stale or corrupt.
+std::optional<metadata>
+load(const xrt::uuid& uuid, std::string_view xml);
+
+// store() - Write meta data for xclbin to cache
+void
+store(const xrt::uuid& uuid, std::string_view xml, const metadata& md);
+
+} // xrt_core::xclbin::metadata_cache
+
+#endif
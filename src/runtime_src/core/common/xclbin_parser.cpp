@@ -15,12 +15,19 @@
  */
 #define XRT_CORE_COMMON_SOURCE
 #include "xclbin_parser.h"
+#include "xclbin_metadata_cache.h"
 #include "config_reader.h"
 #include "error.h"
 
 #include <algorithm>
+#include <functional>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
+#include <string_view>
 #include <cstring>
 #include <cstdlib>
 #include <boost/property_tree/ptree.hpp>
@@ -39,6 +46,8 @@ namespace {
 
 namespace pt = boost::property_tree;
 using kernel_type = xrt_core::xclbin::kernel_properties::kernel_type;
+using kernel_argument = xrt_core::xclbin::kernel_argument;
+using kernel_properties = xrt_core::xclbin::kernel_properties;
 
 // NOLINTNEXTLINE
 constexpr size_t operator"" _kb(unsigned long long v)  { return 1024u * v; }
@@ -387,6 +396,332 @@ merge_args(std::vector<xrt_core::xclbin::kernel_argument>& args)
       throw std::runtime_error("xclbin parser internal error: mismatched argument index");
 }
 
+// Extract arguments of a kernel from its kernel xml entry
+static std::vector<kernel_argument>
+parse_kernel_arguments(const pt::ptree& xml_kernel)
+{
+  std::vector<kernel_argument> args;
+  auto pwmap = get_portname_width_map(xml_kernel);
+
+  for (auto& xml_arg : xml_kernel) {
+    if (xml_arg.first != "arg")
+      continue;
+
+    std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
+    size_t index = id.empty() ? kernel_argument::no_index : convert(id);
+
+    std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
+    auto itr = pwmap.find(port);
+    size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
+
+    args.emplace_back(kernel_argument{
+        xml_arg.second.get<std::string>("<xmlattr>.name")
+       ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
+       ,std::move(port)
+       ,pwidth
+       ,index
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
+       ,0  // fa_desc_offset post computed if necessary
+       ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
+       ,kernel_argument::direction(kernel_argument::direction::input)
+    });
+  }
+
+  // stable sort to preserve order of multi-component arguments
+  // for example global_size, local_size, etc.
+  std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+
+  // merge args with same index
+  merge_args(args);
+
+  return args;
+}
+
+// Extract properties of a kernel from its kernel xml entry.  The
+// properties are as specified in the xml, see apply_ini_properties()
+static kernel_properties
+parse_kernel_properties(const pt::ptree& xml_kernel, const std::string& kname)
+{
+  // Determine features
+  auto mailbox = convert_to_mailbox_type(xml_kernel.get<std::string>("<xmlattr>.mailbox", "none"));
+  auto restart = convert(xml_kernel.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
+  auto sw_reset = to_bool(xml_kernel.get<std::string>("<xmlattr>.swReset", "false"));
+
+  auto functional = get_functional(xml_kernel, "extended-data");
+  auto kernel_id = get_kernel_id(xml_kernel, "extended-data");
+
+  return kernel_properties
+    { kname
+    , to_kernel_type(xml_kernel.get<std::string>("<xmlattr>.type", "pl"))
+    , restart
+    , mailbox
+    , get_address_range(xml_kernel)
+    , sw_reset
+    , functional
+    , kernel_id
+
+    , convert(xml_kernel.get<std::string>("<xmlattr>.workGroupSize", "0"))
+    , get_xyz(xml_kernel, "compileWorkGroupSize")
+    , get_xyz(xml_kernel, "maxWorkGroupSize")
+    , get_stringtable(xml_kernel) };
+}
+
+// Features not specified in the xml can be enabled in xrt.ini
+static kernel_properties
+apply_ini_properties(kernel_properties props)
+{
+  if (props.mailbox == kernel_properties::mailbox_type::none)
+    props.mailbox = get_mailbox_from_ini(props.name);
+  if (props.counted_auto_restart == 0)
+    props.counted_auto_restart = get_restart_from_ini(props.name);
+  if (!props.sw_reset)
+    props.sw_reset = get_sw_reset_from_ini(props.name);
+  return props;
+}
+
+// class xml_metadata - Parsed EMBEDDED_METADATA xml
+//
+// The xml is parsed once and the kernel entries are indexed by name.
+// Kernel arguments and properties are extracted from the kernel entry
+// when first requested and memoized for subsequent requests.
+//
+// Meta data loaded from the persistent cache has the arguments and
+// properties of all kernels up front.  The xml is then parsed only
+// if some other part of the xml is requested.
+class xml_metadata
+{
+  std::string m_xml;  // copy of xml parsed on demand, if loaded from cache
+  bool m_cached = false;
+  std::string m_project_name;
+  std::string m_fpga_device_name;
+
+  mutable std::once_flag m_parsed;
+  mutable pt::ptree m_project;
+  mutable std::vector<std::string> m_kernel_names;
+  mutable std::map<std::string, const pt::ptree*> m_kernels;
+
+  mutable std::mutex m_mutex;
+  mutable std::map<std::string, std::vector<kernel_argument>> m_args;
+  mutable std::map<std::string, kernel_properties> m_properties;
+
+  void
+  parse(const char* xml_data, size_t xml_size) const
+  {
+    std::stringstream xml_stream;
+    xml_stream.write(xml_data, xml_size);
+    pt::read_xml(xml_stream, m_project);
+
+    auto core = m_project.get_child_optional("project.platform.device.core");
+    if (!core)
+      return;
+
+    for (auto& xml_kernel : *core) {
+      if (xml_kernel.first != "kernel")
+        continue;
+
+      auto kname = xml_kernel.second.get<std::string>("<xmlattr>.name");
+      m_kernels.emplace(kname, &xml_kernel.second); // first entry wins
+      if (!m_cached)
+        m_kernel_names.push_back(std::move(kname));
+    }
+  }
+
+  // Return kernel entry or nullptr if no such kernel.  Throws if
+  // the xml has no kernels section, same as walking the ptree.
+  const pt::ptree*
+  get_kernel(const std::string& kname) const
+  {
+    get_core();
+    auto itr = m_kernels.find(kname);
+    return itr != m_kernels.end() ? (*itr).second : nullptr;
+  }
+
+public:
+  xml_metadata(const char* xml_data, size_t xml_size)
+  {
+    std::call_once(m_parsed, [this, xml_data, xml_size] { parse(xml_data, xml_size); });
+  }
+
+  xml_metadata(std::string_view xml, xrt_core::xclbin::metadata_cache::metadata&& md)
+    : m_xml(xml)
+    , m_cached(true)
+    , m_project_name(std::move(md.project_name))
+    , m_fpga_device_name(std::move(md.fpga_device_name))
+  {
+    m_kernel_names = std::move(md.kernel_names);
+    m_args = std::move(md.args);
+    for (auto& [kname, props] : md.properties)
+      m_properties.emplace(kname, apply_ini_properties(std::move(props)));
+  }
+
+  const pt::ptree&
+  get_project() const
+  {
+    std::call_once(m_parsed, [this] { parse(m_xml.data(), m_xml.size()); });
+    return m_project;
+  }
+
+  const pt::ptree&
+  get_core() const
+  {
+    return get_project().get_child("project.platform.device.core");
+  }
+
+  std::string
+  get_project_name() const
+  {
+    return m_cached
+      ? m_project_name
+      : get_project().get<std::string>("project.<xmlattr>.name","");
+  }
+
+  std::string
+  get_fpga_device_name() const
+  {
+    return m_cached
+      ? m_fpga_device_name
+      : get_project().get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
+  }
+
+  const std::vector<std::string>&
+  get_kernel_names() const
+  {
+    if (!m_cached)
+      get_core();
+    return m_kernel_names;
+  }
+
+  std::vector<kernel_argument>
+  get_kernel_arguments(const std::string& kname) const
+  {
+    if (m_cached) {
+      auto itr = m_args.find(kname);
+      return itr != m_args.end() ? (*itr).second : std::vector<kernel_argument>{};
+    }
+
+    auto xml_kernel = get_kernel(kname);
+    if (!xml_kernel)
+      return {};
+
+    std::lock_guard lk(m_mutex);
+    if (auto itr = m_args.find(kname); itr != m_args.end())
+      return (*itr).second;
+
+    return m_args.emplace(kname, parse_kernel_arguments(*xml_kernel)).first->second;
+  }
+
+  kernel_properties
+  get_kernel_properties(const std::string& kname) const
+  {
+    if (m_cached) {
+      auto itr = m_properties.find(kname);
+      return itr != m_properties.end() ? (*itr).second : kernel_properties{};
+    }
+
+    auto xml_kernel = get_kernel(kname);
+    if (!xml_kernel)
+      return kernel_properties{};
+
+    std::lock_guard lk(m_mutex);
+    if (auto itr = m_properties.find(kname); itr != m_properties.end())
+      return (*itr).second;
+
+    auto props = apply_ini_properties(parse_kernel_properties(*xml_kernel, kname));
+    return m_properties.emplace(kname, std::move(props)).first->second;
+  }
+
+  // Meta data for the persistent cache.  Throws if the xml has no
+  // kernels section or if any kernel entry is malformed.
+  xrt_core::xclbin::metadata_cache::metadata
+  get_cache_metadata() const
+  {
+    xrt_core::xclbin::metadata_cache::metadata md;
+    md.project_name = get_project_name();
+    md.fpga_device_name = get_fpga_device_name();
+    md.kernel_names = get_kernel_names();
+    for (const auto& [kname, xml_kernel] : m_kernels) {
+      md.args.emplace(kname, parse_kernel_arguments(*xml_kernel));
+      md.properties.emplace(kname, parse_kernel_properties(*xml_kernel, kname));
+    }
+    return md;
+  }
+};
+
+// Meta data from the persistent cache if the xclbin is cached,
+// otherwise parse the xml and add its meta data to the cache for
+// subsequent processes loading the same xclbin.
+static std::shared_ptr<const xml_metadata>
+load_cached_xml_metadata(const char* xml_data, size_t xml_size, const xrt::uuid& uuid)
+{
+  std::string_view xml{xml_data, xml_size};
+  if (auto md = xrt_core::xclbin::metadata_cache::load(uuid, xml))
+    return std::make_shared<const xml_metadata>(xml, std::move(*md));
+
+  auto metadata = std::make_shared<const xml_metadata>(xml_data, xml_size);
+  try {
+    xrt_core::xclbin::metadata_cache::store(uuid, xml, metadata->get_cache_metadata());
+  }
+  catch (const std::exception&) {
+    // Not cached, errors are reported when the xml is queried
+  }
+  return metadata;
+}
+
+// get_xml_metadata() - Get parsed xml metadata
+//
+// Parsed xml is cached for a few most recently used xml sections.
+// An xclbin is typically processed by several users (xclbin, kernel,
+// and device objects) in close succession, all of which share the
+// same parsed xml.  Entries are looked up by content hash and a hit
+// is confirmed by comparing the xml with a copy kept in the entry,
+// so different xml sections never share parsed meta data.
+//
+// If the uuid of the xclbin is known, then the xml is looked up in
+// the persistent cache when enabled in xrt.ini.
+static std::shared_ptr<const xml_metadata>
+get_xml_metadata(const char* xml_data, size_t xml_size, const xrt::uuid* uuid = nullptr)
+{
+  struct entry_type
+  {
+    size_t hash;
+    std::string xml;
+    std::shared_ptr<const xml_metadata> metadata;
+  };
+  constexpr size_t max_entries = 8;
+
+  static std::mutex mutex;
+  static std::list<entry_type> entries; // most recently used first
+
+  std::string_view xml{xml_data, xml_size};
+  auto hash = std::hash<std::string_view>{}(xml);
+
+  {
+    std::lock_guard lk(mutex);
+    auto itr = std::find_if(entries.begin(), entries.end(), [hash, xml](const auto& e) {
+      return e.hash == hash && e.xml.size() == xml.size()
+        && std::memcmp(e.xml.data(), xml.data(), xml.size()) == 0;
+    });
+    if (itr != entries.end()) {
+      entries.splice(entries.begin(), entries, itr);
+      return entries.front().metadata;
+    }
+  }
+
+  // Parse outside of lock, a concurrent parse of same xml is benign
+  auto metadata = (uuid && xrt_core::xclbin::metadata_cache::enabled())
+    ? load_cached_xml_metadata(xml_data, xml_size, *uuid)
+    : std::make_shared<const xml_metadata>(xml_data, xml_size);
+
+  std::lock_guard lk(mutex);
+  entries.push_front({hash, std::string{xml}, metadata});
+  if (entries.size() > max_entries)
+    entries.pop_back();
+
+  return metadata;
+}
+
 
 } // namespace
 
@@ -472,10 +807,8 @@ get_first_used_mem(const axlf* top)
 size_t
 get_max_cu_size(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  auto metadata = get_xml_metadata(xml_data, xml_size);
+  const auto& xml_project = metadata->get_project();
 
   size_t maxsz = 0;
 
@@ -627,10 +960,8 @@ get_cus(const char* xml_data, size_t xml_size, bool)
 {
   std::vector<uint64_t> cus;
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data, xml_size);
-  pt::read_xml(xml_stream, xml_project);
+  auto metadata = get_xml_metadata(xml_data, xml_size);
+  const auto& xml_project = metadata->get_project();
 
   for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
     if (xml_kernel.first != "kernel")
@@ -896,10 +1227,8 @@ get_kernel_freq(const axlf* top)
   size_t kernel_clk_freq = default_kernel_clk_freq;
   auto xml = get_xml_section(top);
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml.first,xml.second);
-  pt::read_xml(xml_stream,xml_project);
+  auto metadata = get_xml_metadata(xml.first, xml.second);
+  const auto& xml_project = metadata->get_project();
 
   auto clock_child = xml_project.get_child_optional("project.platform.device.core.kernelClocks");
 
@@ -925,60 +1254,16 @@ get_kernel_freq(const axlf* top)
   return kernel_clk_freq;
 }
 
+void
+load_xml_metadata(const char* xml_data, size_t xml_size, const xrt::uuid& uuid)
+{
+  get_xml_metadata(xml_data, xml_size, &uuid);
+}
+
 std::vector<kernel_argument>
 get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  std::vector<kernel_argument> args;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    auto pwmap = get_portname_width_map(xml_kernel.second);
-
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
-      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
-
-      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
-      auto itr = pwmap.find(port);
-      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
-
-      args.emplace_back(kernel_argument{
-          xml_arg.second.get<std::string>("<xmlattr>.name")
-         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
-         ,std::move(port)
-         ,pwidth
-         ,index
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
-         ,0  // fa_desc_offset post computed if necessary
-         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
-         ,kernel_argument::direction(kernel_argument::direction::input)
-      });
-    }
-
-    // stable sort to preserve order of multi-component arguments
-    // for example global_size, local_size, etc.
-    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
-
-    // merge args with same index
-    merge_args(args);
-
-    break;
-  }
-  return args;
+  return get_xml_metadata(xml_data, xml_size)->get_kernel_arguments(kname);
 }
 
 std::vector<kernel_argument>
@@ -991,49 +1276,7 @@ get_kernel_arguments(const axlf* top, const std::string& kname)
 kernel_properties
 get_kernel_properties(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
-
-    // Determine features
-    auto mailbox = convert_to_mailbox_type(xml_kernel.second.get<std::string>("<xmlattr>.mailbox", "none"));
-    if (mailbox == kernel_properties::mailbox_type::none)
-      mailbox = get_mailbox_from_ini(kname);
-    auto restart = convert(xml_kernel.second.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
-    if (restart == 0)
-      restart = get_restart_from_ini(kname);
-    auto sw_reset = to_bool(xml_kernel.second.get<std::string>("<xmlattr>.swReset", "false"));
-    if (!sw_reset)
-      sw_reset = get_sw_reset_from_ini(kname);
-
-    auto functional = get_functional(xml_kernel.second, "extended-data");
-    auto kernel_id = get_kernel_id(xml_kernel.second, "extended-data");
-
-    return kernel_properties
-      { kname
-      , to_kernel_type(xml_kernel.second.get<std::string>("<xmlattr>.type", "pl"))
-      , restart
-      , mailbox
-      , get_address_range(xml_kernel.second)
-      , sw_reset
-      , functional
-      , kernel_id
-
-      , convert(xml_kernel.second.get<std::string>("<xmlattr>.workGroupSize", "0"))
-      , get_xyz(xml_kernel.second, "compileWorkGroupSize")
-      , get_xyz(xml_kernel.second, "maxWorkGroupSize")
-      , get_stringtable(xml_kernel.second) };
-
-  }
-
-  return kernel_properties{};
+  return get_xml_metadata(xml_data, xml_size)->get_kernel_properties(kname);
 }
 
 kernel_properties
@@ -1046,21 +1289,7 @@ get_kernel_properties(const axlf* top, const std::string& kname)
 std::vector<std::string>
 get_kernel_names(const char *xml_data, size_t xml_size)
 {
-  std::vector<std::string> names;
-
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-
-    names.push_back(xml_kernel.second.get<std::string>("<xmlattr>.name"));
-  }
-
-  return names;
+  return get_xml_metadata(xml_data, xml_size)->get_kernel_names();
 }
 
 std::vector<kernel_object>
@@ -1068,12 +1297,12 @@ get_kernels(const char* xml_data, size_t xml_size)
 {
   std::vector<kernel_object> kernels;
 
-  auto knames = get_kernel_names(xml_data, xml_size);
-  for (auto& kname : get_kernel_names(xml_data, xml_size)) {
-    auto kprop = get_kernel_properties(xml_data, xml_size, kname);
+  auto metadata = get_xml_metadata(xml_data, xml_size);
+  for (auto& kname : metadata->get_kernel_names()) {
+    auto kprop = metadata->get_kernel_properties(kname);
     kernels.emplace_back(kernel_object{
         kname
-       ,get_kernel_arguments(xml_data, xml_size, kname)
+       ,metadata->get_kernel_arguments(kname)
        ,kprop.address_range
        ,kprop.sw_reset
     });
@@ -1086,6 +1315,7 @@ std::vector<kernel_object>
 get_kernels(const axlf* top)
 {
   auto xml = get_xml_section(top);
+  load_xml_metadata(xml.first, xml.second, xrt::uuid{top->m_header.uuid});
   return get_kernels(xml.first, xml.second);
 }
 
@@ -1110,12 +1340,7 @@ get_vbnv(const axlf* top)
 std::string
 get_project_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  return xml_project.get<std::string>("project.<xmlattr>.name","");
+  return get_xml_metadata(xml_data, xml_size)->get_project_name();
 }
 
 std::string
@@ -1133,12 +1358,7 @@ get_project_name(const axlf* top)
 std::string
 get_fpga_device_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  return xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
+  return get_xml_metadata(xml_data, xml_size)->get_fpga_device_name();
 }
 
 }} // xclbin, xrt_core
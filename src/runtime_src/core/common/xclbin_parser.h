@@ -326,6 +326,22 @@ get_aie_partition(const axlf* top);
 size_t
 get_kernel_freq(const axlf* top);
 
+/**
+ * load_xml_metadata() - Load xml meta data of an xclbin
+ *
+ * @xml_data: XML metadata from xclbin
+ * @xml_size: Size of XML metadata from xclbin
+ * @uuid: UUID of the xclbin
+ *
+ * The xml meta data is loaded from the persistent meta data cache
+ * when enabled in xrt.ini (Runtime.xclbin_metadata_cache), otherwise
+ * the xml is parsed and added to the cache.  Subsequent meta data
+ * queries of the same xml use the loaded meta data.
+ */
+XRT_CORE_COMMON_EXPORT
+void
+load_xml_metadata(const char* xml_data, size_t xml_size, const xrt::uuid& uuid);
+
 /**
  * get_kernel_arguments() - Get argument meta data for a kernel
  *
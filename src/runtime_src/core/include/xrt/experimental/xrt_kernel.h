@@ -10,8 +10,10 @@
 
 #ifdef __cplusplus
 # include "xrt/detail/pimpl.h"
+# include "xrt/detail/span.h"
 # include <chrono>
 # include <condition_variable>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -274,6 +276,43 @@ public:
   reset();
 };
 
+/**
+ * submit_batch() - Start independent run objects with one submission
+ *
+ * @param runs
+ *  Run objects to start.  The run objects can be of different kernels
+ *  but must all be created in the same hardware context.
+ *
+ * The run objects are validated and prepared together and handed to
+ * the hardware queue in one call, which saves the per-run overhead
+ * of xrt::run::start() in XRT.  The driver still receives one
+ * command submission per run object.  Unlike a runlist, the run objects have no ordering or error
+ * dependencies between them and can be modified individually when
+ * not executing.  Completion of each run object is checked with
+ * `xrt::run::wait()` or `xrt::run::state()` as if it had been
+ * started with `xrt::run::start()`.
+ *
+ * Run objects with completion callbacks are started individually.
+ *
+ * Throws if any run object is already running, is part of a
+ * runlist, or is from a different hardware context, in which case
+ * no run object is started.
+ */
+XRT_API_EXPORT
+void
+submit_batch(const xrt::detail::span<const xrt::run>& runs);
+
+/**
+ * submit_batch() - Start independent run objects with one submission
+ *
+ * Convenience overload of submit_batch() for a vector of run objects
+ */
+inline void
+submit_batch(const std::vector<xrt::run>& runs)
+{
+  submit_batch(xrt::detail::span<const xrt::run>{runs.data(), runs.size()});
+}
+
 } // namespace xrt
 
 #endif // __cplusplus
@@ -7,10 +7,13 @@
 #include "xrt/deprecated/xrt.h"
 #include "xrt/detail/xrt_mem.h"
 #include "xrt/detail/pimpl.h"
+#include "xrt/detail/span.h"
 
 #ifdef __cplusplus
+# include <array>
 # include <memory>
 # include <type_traits>
+# include <vector>
 #endif
 
 /**
@@ -142,6 +145,30 @@ public:
   using export_handle = int32_t;
 #endif
 
+  /**
+   * @struct rect - layout of a 2D or 3D region in linear memory
+   *
+   * @var offset
+   *  Byte offset of the first row of the region
+   * @var row_pitch
+   *  Bytes between the start of two rows, 0 means rows are packed
+   * @var slice_pitch
+   *  Bytes between the start of two slices, 0 means slices are packed
+   *
+   * A region is copied as ``region[2]`` slices of ``region[1]`` rows
+   * of ``region[0]`` bytes, where ``region`` is an ``std::array``
+   * argument of the strided read(), write(), and sync() functions.
+   * A non-zero row pitch must be at least ``region[0]`` and a non-zero
+   * slice pitch must be at least ``region[1]`` rows, otherwise the
+   * strided functions throw.
+   */
+  struct rect
+  {
+    size_t offset = 0;
+    size_t row_pitch = 0;
+    size_t slice_pitch = 0;
+  };
+
   /**
    * bo() - Constructor for empty bo
    *
@@ -609,6 +636,28 @@ public:
     sync(dir, size(), 0);
   }
 
+  /**
+   * sync() - Synchronize a strided region with device side
+   *
+   * @param dir
+   *  To device or from device
+   * @param bo_rect
+   *  Layout of the region within the BO
+   * @param region
+   *  Bytes per row, rows per slice, and number of slices
+   *
+   * Sync to device transfers only the rows of the region, such that
+   * device data in the gaps between rows is not overwritten.  Rows
+   * that are contiguous are transferred together.  Sync from device
+   * transfers the range of the buffer from the first to the last
+   * byte of the region in one transfer, including the gaps between
+   * rows.  Throws if the region extends past the end of the BO or if
+   * the pitches of ``bo_rect`` are too small for the region.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  sync(xclBOSyncDirection dir, const rect& bo_rect, const std::array<size_t, 3>& region);
+
   /**
    * map() - Map the host side buffer into application
    *
@@ -699,6 +748,31 @@ public:
     write(src, size(), 0);
   }
 
+  /**
+   * write() - Copy-in a strided region of user data
+   *
+   * @param src
+   *  Source data pointer
+   * @param src_rect
+   *  Layout of the region in source data
+   * @param bo_rect
+   *  Layout of the region within the BO
+   * @param region
+   *  Bytes per row, rows per slice, and number of slices
+   *
+   * Copy rows of source data to host buffer of this buffer object,
+   * e.g. a region of interest of an image.  Rows that are contiguous
+   * in both source and BO are copied together.  Throws if the region
+   * extends past the end of the BO or if the pitches of a layout are
+   * too small for the region.
+   *
+   * If BO has no host backing storage, e.g. a device only buffer,
+   * then each row is written directly to the device buffer.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  write(const void* src, const rect& src_rect, const rect& bo_rect, const std::array<size_t, 3>& region);
+
   /**
    * read() - Copy-out user data from host backing storage of BO
    *
@@ -739,6 +813,30 @@ public:
     read(dst, size(), 0);
   }
 
+  /**
+   * read() - Copy-out a strided region of user data
+   *
+   * @param dst
+   *  Destination data pointer
+   * @param dst_rect
+   *  Layout of the region in destination data
+   * @param bo_rect
+   *  Layout of the region within the BO
+   * @param region
+   *  Bytes per row, rows per slice, and number of slices
+   *
+   * Copy rows of host buffer of this buffer object to destination.
+   * Rows that are contiguous in both BO and destination are copied
+   * together.  Throws if the region extends past the end of the BO
+   * or if the pitches of a layout are too small for the region.
+   *
+   * If BO has no host backing storage, e.g. a device only buffer,
+   * then each row is read directly from the device buffer.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  read(void* dst, const rect& dst_rect, const rect& bo_rect, const std::array<size_t, 3>& region);
+
   /**
    * copy() - Deep copy BO content from another buffer
    *
@@ -798,6 +896,58 @@ private:
   std::shared_ptr<bo_impl> handle;
 };
 
+/**
+ * @struct bo_sync_range - range of a buffer to synchronize
+ *
+ * @var bo
+ *  Buffer or sub-buffer with the range
+ * @var dir
+ *  To device or from device
+ * @var size
+ *  Size of data to synchronize
+ * @var offset
+ *  Offset within the buffer
+ */
+struct bo_sync_range
+{
+  xrt::bo bo;
+  xclBOSyncDirection dir;
+  size_t size;
+  size_t offset;
+};
+
+/**
+ * sync_many() - Synchronize several buffer ranges with device side
+ *
+ * @param ranges
+ *  Buffer ranges to synchronize
+ *
+ * Ranges of sub-buffers are synchronized through their parent
+ * buffer.  Overlapping or adjacent ranges of the same parent buffer
+ * and direction are merged.  Each merged range is synchronized with
+ * its own call to the driver, so the saving over syncing each
+ * sub-buffer individually comes from merging adjacent ranges, e.g.
+ * the contiguous slices of a sliced buffer become one sync.
+ * Non-adjacent ranges cost the same as individual syncs.
+ *
+ * Throws if any range exceeds its buffer, in which case no range
+ * is synchronized.
+ */
+XCL_DRIVER_DLLESPEC
+void
+sync_many(const xrt::detail::span<const bo_sync_range>& ranges);
+
+/**
+ * sync_many() - Synchronize several buffer ranges with device side
+ *
+ * Convenience overload of sync_many() for a vector of ranges
+ */
+inline void
+sync_many(const std::vector<bo_sync_range>& ranges)
+{
+  sync_many(xrt::detail::span<const bo_sync_range>{ranges.data(), ranges.size()});
+}
+
 } // namespace xrt
 
 /// @cond
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <list>
 #include <map>
+#include <set>
 #include <cassert>
 #include <algorithm>
 
@@ -30,20 +31,28 @@ namespace xclemulation
 {
 static std::map<uint64_t,uint64_t> DEFAULT_MAP;
 static std::string DEFAULT_TAG("");
+    // Device memory allocator
+    //
+    // Free ranges are indexed both by address, to coalesce a freed
+    // range with its neighbors, and by (size, address), to find the
+    // smallest free range that fits a request.  Busy ranges are
+    // indexed by address.  Allocation and free are O(log n) in the
+    // number of ranges.
     class MemoryManager 
     {
+        typedef std::map<uint64_t, uint64_t> RangeMap;              // address -> size
+        typedef std::set<std::pair<uint64_t, uint64_t> > SizeIndex; // (size, address)
+
         std::mutex mMemManagerMutex;
-        std::list<std::pair<uint64_t, uint64_t> > mFreeBufferList;
-        std::list<std::pair<uint64_t, uint64_t> > mBusyBufferList;
+        RangeMap mFreeBufferMap;
+        SizeIndex mFreeBufferIndex;
+        RangeMap mBusyBufferMap;
         uint64_t mSize;
         uint64_t mStart;
         uint64_t mAlignment;
 	std::string mTag;
-        const unsigned mCoalesceThreshold;
         uint64_t mFreeSize;
 
-        typedef std::list<std::pair<uint64_t, uint64_t> > PairList;
-
     public:
 	static const uint64_t mNull = 0xffffffffffffffffull;
 	std::list<MemoryManager*> mChildMemories;
@@ -64,8 +73,8 @@ static std::string DEFAULT_TAG("");
         std::pair<uint64_t, uint64_t>lookup(uint64_t buf);
 
     private:
-        void coalesce();
-        PairList::iterator find(uint64_t buf);
+        void insertFree(uint64_t addr, uint64_t size);
+        void eraseFree(RangeMap::iterator it);
     };
 }
 
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Unit benchmark for the emulation device memory allocator
+//
+// % cmake -B build -DXRT_SOURCE_DIR=<path to XRT/src>
+// % cmake --build build --config <Release|Debug>
+//
+// % <path>/memorymanager -n 50000 -i 10
+//
+// Allocates -n buffers of random page aligned sizes, then churns
+// through -i iterations each freeing a random half of the live
+// buffers and allocating them again.  The allocator state is
+// validated at the end: all buffers are freed and the full range
+// must be allocatable again as a single buffer.
+
+#include "memorymanager.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: memorymanager [options]\n"
+            << " [-n <buffers>] number of live buffers (default 20000)\n"
+            << " [-i <iterations>] number of churn iterations (default 10)\n";
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  size_t buffers = 20000;   // NOLINT
+  size_t iterations = 10;   // NOLINT
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-n")
+      buffers = std::stoul(arg);
+    else if (cur == "-i")
+      iterations = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  constexpr uint64_t page = 4096;
+  constexpr uint64_t memsize = 0x400000000; // 16GB
+  xclemulation::MemoryManager mm(memsize, 0, page);
+
+  std::mt19937_64 rng(42); // NOLINT
+  std::uniform_int_distribution<size_t> sizes(1, 64 * page);
+  std::vector<uint64_t> live(buffers, xclemulation::MemoryManager::mNull);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (auto& buf : live) {
+    size_t sz = sizes(rng);
+    buf = mm.alloc(sz);
+    if (buf == xclemulation::MemoryManager::mNull)
+      throw std::runtime_error("initial allocation failed");
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "alloc " << buffers << " buffers: "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  start = std::chrono::high_resolution_clock::now();
+  for (size_t itr = 0; itr < iterations; ++itr) {
+    std::shuffle(live.begin(), live.end(), rng);
+    for (size_t idx = 0; idx < buffers / 2; ++idx)
+      mm.free(live[idx]);
+    for (size_t idx = 0; idx < buffers / 2; ++idx) {
+      size_t sz = sizes(rng);
+      live[idx] = mm.alloc(sz);
+      if (live[idx] == xclemulation::MemoryManager::mNull)
+        throw std::runtime_error("churn allocation failed");
+    }
+  }
+  end = std::chrono::high_resolution_clock::now();
+  std::cout << "churn " << iterations << " x " << buffers / 2 << " free/alloc: "
+            << std::chrono::duration<double, std::milli>(end - start).count() << "ms\n";
+
+  for (auto buf : live) {
+    if (xclemulation::MemoryManager::isNullAlloc(mm.lookup(buf)))
+      throw std::runtime_error("lookup of live buffer failed");
+    mm.free(buf);
+  }
+
+  if (mm.freeSize() != memsize)
+    throw std::runtime_error("free size mismatch after freeing all buffers");
+
+  size_t all = memsize;
+  if (mm.alloc(all) != 0)
+    throw std::runtime_error("free ranges not coalesced after freeing all buffers");
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -16,12 +16,50 @@
 
 #include "mem_model.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Sort banks by address and merge overlapping banks, e.g. bank groups
+// spanning other banks, into one range.
+static std::vector<mem_model::bank>
+merge_banks(std::vector<mem_model::bank> banks)
+{
+  banks.erase(std::remove_if(banks.begin(), banks.end(),
+                             [](const auto& b) { return b.size == 0; }),
+              banks.end());
+  std::sort(banks.begin(), banks.end(),
+            [](const auto& b1, const auto& b2) { return b1.base_addr < b2.base_addr; });
+
+  std::vector<mem_model::bank> merged;
+  for (const auto& b : banks) {
+    if (!merged.empty() && b.base_addr <= merged.back().base_addr + merged.back().size) {
+      auto& last = merged.back();
+      last.size = std::max(last.base_addr + last.size, b.base_addr + b.size) - last.base_addr;
+      continue;
+    }
+    merged.push_back(b);
+  }
+  return merged;
+}
+
 mem_model::~ mem_model()
 {
-  serialize();
+  for (auto& [base, reg] : mRegions)
+    munmap(reg.data, reg.size);
 }
 
-mem_model::mem_model(std::string deviceName):
+mem_model::mem_model(std::string deviceName, std::vector<bank> banks):
+  mBanks(merge_banks(std::move(banks))),
   mDeviceName(deviceName),
   module_name("dr_wrapper_dr_i_sdaccel_generic_pcie_0.sdaccel_generic_pcie_model.ddrx_top_tlm_model_0.axi_app_tlm_model_0")
 {
@@ -29,157 +67,100 @@ mem_model::mem_model(std::string deviceName):
 
   unsigned int mem_model::writeDevMem(uint64_t offset, const void* src, unsigned int size)
   {
-#ifdef DEBUGMSG
-      cout<<endl<<module_name<<" write offset:"<<std::hex<<offset<<endl;
-#endif 
-      uint64_t written_bytes = 0;
-      uint64_t addr = offset;
-      while(written_bytes < size){
-          uint64_t src_offset = written_bytes;
-
-          unsigned char* page_ptr  = get_page(addr);
-          uint64_t       page_addr = addr & ~( ~uint64_t(0) << ADDRBITS);
-
-          unsigned char* dest_buf_ptr = page_ptr + page_addr;
-          unsigned char* src_buf_ptr  = (unsigned char*)(src)      + src_offset;
-
-          uint64_t remaining_bytes_to_write = size - written_bytes;
-          uint64_t unaligned_bytes_in_addr = (addr & ~(~uint64_t(0) << ADDRBITS));
-          uint64_t bytes_upto_next_alignment = (0x1 << ADDRBITS) - unaligned_bytes_in_addr;
-
-          uint64_t buf_size = 0;
-          if(bytes_upto_next_alignment > remaining_bytes_to_write)
-          {
-              buf_size = remaining_bytes_to_write;
-          }else{
-              buf_size = bytes_upto_next_alignment;
-          }
-
-          memcpy(dest_buf_ptr,src_buf_ptr,buf_size);
-
-          written_bytes += buf_size;
-          addr += buf_size;
-      }
-#ifdef DEBUGMSG
-      std::cout << endl;
-      std::cout << "Write Operation size : " << size << endl;
-      for(int i = 0; i < size;i++){
-          cout << std::hex << (unsigned int)(((unsigned char*)src)[i]) << " ";
-      }
-      std::cout << endl;
-      cout << "Write : " ;
-      cout << "Offset --> " << offset << endl;
-#endif    
-
-      return 0;
+    uint64_t written_bytes = 0;
+    uint64_t addr = offset;
+    while (written_bytes < size) {
+      auto reg = get_region(addr);
+      auto buf_size = std::min<uint64_t>(size - written_bytes, reg->base_addr + reg->size - addr);
+      std::memcpy(reg->data + (addr - reg->base_addr), static_cast<const unsigned char*>(src) + written_bytes, buf_size);
+      written_bytes += buf_size;
+      addr += buf_size;
+    }
+    return 0;
   }
 
-  unsigned int mem_model::readDevMem(uint64_t offset, void* dest, unsigned int size){
-#ifdef DEBUGMSG
-	  cout<<endl<<module_name<<" read offset:"<<std::hex<< (uint64_t)offset<<endl;
-#endif 
-	 
-	  uint64_t read_bytes = 0;
-	  uint64_t addr = offset;
-	  while(read_bytes < size){
-		  uint64_t dest_offset = read_bytes;
-
-		  unsigned char* page_ptr  = get_page(addr);
-		  uint64_t       page_addr = addr & ~(~uint64_t(0) << ADDRBITS);
-
-		  unsigned char* src_buf_ptr = page_ptr + page_addr;
-		  unsigned char* dest_buf_ptr  = (unsigned char*)(dest)      + dest_offset;
-
-		  uint64_t remaining_bytes_to_read = size - read_bytes;
-		  uint64_t unaligned_bytes_in_addr = (addr & ~(~uint64_t(0) << ADDRBITS));
-		  uint64_t bytes_upto_next_alignment = (0x1 << ADDRBITS) - unaligned_bytes_in_addr;
-
-		  uint64_t buf_size = 0;
-		  if(bytes_upto_next_alignment > remaining_bytes_to_read)
-		  {
-			  buf_size = remaining_bytes_to_read;
-		  }else{
-			  buf_size = bytes_upto_next_alignment;
-		  }
-	  memcpy(dest_buf_ptr,src_buf_ptr,buf_size);
-		  read_bytes += buf_size;
-		  addr += buf_size;
-	  }
-#ifdef DEBUGMSG
-	  std::cout << endl;
-	  std::cout << "Read Operation size : " << size << endl;
-	  for(unsigned int i = 0; i < size;i++){
-		  cout << std::hex << (unsigned int)(((unsigned char*)dest)[i]) << " ";
-	  }
-	  std::cout << endl;
-	  cout << "Read : " ;
-	  cout << "Offset --> " << offset << endl;
-#endif    
-
-	  return 0;
-  }
-  unsigned char* mem_model::get_page(uint64_t offset) {
-	  uint64_t page_idx = offset >> ADDRBITS;
-	  std::string file_name = get_mem_file_name(page_idx);
-	  if(pageCache.size() > N_1MBARRAYS)
-	  {
-		  std::cerr << "Out of Memory. DDR model does not support this much of memory\n";
-		  exit(1);
-	  } else {
-      FILE* pFile = NULL;
-		  if(pageCache.find(page_idx) != pageCache.end())
-		  {
-			  return pageCache[page_idx];
-		  } else if(((pFile = fopen(file_name.c_str(),"r")) != NULL)) {
-			  int fhandle = fileno(pFile);
-
-			  if (deserialize_msg.ParseFromFileDescriptor(fhandle) == false)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-
-			  memcpy(pageCache[page_idx],deserialize_msg.data().c_str(),PAGESIZE);
-			  fclose(pFile);
-			  return pageCache[page_idx];
-		  } else {
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-			  return pageCache[page_idx];
-		  }
-	  }
+  unsigned int mem_model::readDevMem(uint64_t offset, void* dest, unsigned int size)
+  {
+    uint64_t read_bytes = 0;
+    uint64_t addr = offset;
+    while (read_bytes < size) {
+      auto reg = get_region(addr);
+      auto buf_size = std::min<uint64_t>(size - read_bytes, reg->base_addr + reg->size - addr);
+      std::memcpy(static_cast<unsigned char*>(dest) + read_bytes, reg->data + (addr - reg->base_addr), buf_size);
+      read_bytes += buf_size;
+      addr += buf_size;
+    }
+    return 0;
   }
 
+  // Get the region containing addr, map the region if necessary.
+  // Regions are never unmapped while the model is alive, so the
+  // returned region can be used without holding the lock.
+  mem_model::region* mem_model::get_region(uint64_t addr)
+  {
+    std::lock_guard<std::mutex> lk(mMutex);
+    auto itr = mRegions.upper_bound(addr);
+    if (itr != mRegions.begin()) {
+      auto& reg = (--itr)->second;
+      if (addr < reg.base_addr + reg.size)
+        return &reg;
+    }
+
+    // Bank containing addr
+    auto bitr = std::upper_bound(mBanks.begin(), mBanks.end(), addr,
+                                 [](uint64_t a, const bank& b) { return a < b.base_addr; });
+    if (bitr != mBanks.begin() && addr < (bitr - 1)->base_addr + (bitr - 1)->size)
+      return map_region((bitr - 1)->base_addr, (bitr - 1)->size);
+
+    // Address outside of known banks, map a default sized region
+    // clipped to not overlap with known banks or mapped regions
+    uint64_t base = addr & ~(default_region_size - 1);
+    uint64_t end = base + default_region_size;
+    if (bitr != mBanks.begin())
+      base = std::max(base, (bitr - 1)->base_addr + (bitr - 1)->size);
+    if (bitr != mBanks.end())
+      end = std::min(end, bitr->base_addr);
+    itr = mRegions.upper_bound(addr);
+    if (itr != mRegions.end())
+      end = std::min(end, itr->first);
+    if (itr != mRegions.begin()) {
+      --itr;
+      base = std::max(base, itr->second.base_addr + itr->second.size);
+    }
+    return map_region(base, end - base);
+  }
 
-  void mem_model::serialize() {
-     FILE *pFile;
-     int fhandle;
-     for (pageCacheItr=pageCache.begin(); pageCacheItr != pageCache.end(); ++pageCacheItr)
-     {
-        std::string file_name = get_mem_file_name(pageCacheItr->first);
-        pFile = fopen(file_name.c_str(),"w+");
-        if(!pFile)
-          continue;
-        fhandle = fileno(pFile);
-        if(fhandle == -1)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-
-        serialize_msg.set_data(reinterpret_cast<const char*>(pageCacheItr->second),PAGESIZE);
-        if(serialize_msg.SerializeToFileDescriptor(fhandle) == false)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-        fclose(pFile);
-     }
+  mem_model::region* mem_model::map_region(uint64_t base_addr, uint64_t size)
+  {
+    auto file_name = get_mem_file_name(base_addr);
+    int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0666);
+    if (fd == -1) {
+      std::cerr << "Unable to open memory model file " << file_name << ": " << strerror(errno) << std::endl;
+      exit(1);
+    }
+
+    // Grow, but never shrink, a file persisted by an earlier run
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) == -1 || (static_cast<uint64_t>(statBuf.st_size) < size && ftruncate(fd, size) == -1)) {
+      std::cerr << "Unable to size memory model file " << file_name << ": " << strerror(errno) << std::endl;
+      close(fd);
+      exit(1);
+    }
+
+    auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      std::cerr << "Unable to map memory model file " << file_name << ": " << strerror(errno) << std::endl;
+      exit(1);
+    }
+
+    auto& reg = mRegions[base_addr];
+    reg = region{base_addr, size, static_cast<unsigned char*>(data)};
+    return &reg;
   }
 
- std::string mem_model::get_mem_file_name(uint64_t pageIdx)
+ std::string mem_model::get_mem_file_name(uint64_t base_addr)
  {
-   std::string file_name("");
    std::string user("");
    char* cUser = getenv("USER");
    if(cUser)
@@ -189,21 +170,15 @@ mem_model::mem_model(std::string deviceName):
    std::string file_path("");
    if(mDeviceName.empty() == false)
      file_path = "/tmp/" + user + "/" + std::to_string(getpid()) + "/hw_emu/" + mDeviceName + "/" + module_name + "/";
-    else
+   else
      file_path = "/tmp/" + user + "/hw_emu/" + module_name + "/";
-   std::stringstream mkdirCommand;
-   mkdirCommand<<"mkdir -p "<<file_path;;
-   struct stat statBuf;
-   if ( stat(file_path.c_str(), &statBuf) == -1 )
-   {
-     int rV = system(mkdirCommand.str().c_str());
-     if(rV == -1) {std::cout<<"unable to open/create mem file"<<std::endl;}
-   }
-    file_name = file_path + module_name + "_" + std::to_string(pageIdx);
-#ifdef DEBUGMSG
-      cout<<"ddr fmodel file_name: "<< file_name<<endl;
-#endif
-    return file_name;
- }
 
+   std::error_code ec;
+   std::filesystem::create_directories(file_path, ec);
+   if (ec)
+     std::cout << "unable to open/create mem file" << std::endl;
 
+   std::stringstream file_name;
+   file_name << file_path << module_name << "_0x" << std::hex << base_addr << ".mem";
+   return file_name.str();
+ }
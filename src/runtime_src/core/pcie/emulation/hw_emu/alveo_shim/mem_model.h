@@ -16,47 +16,64 @@
 
 #ifndef OCL_PLATFORM_H
 #define OCL_PLATFORM_H
-#include <math.h>
-#include <iostream>
-
-#include <string.h> // memcpy
-#include <sstream> // memcpy
-#include <stdlib.h> //realloc
-#include <map> //realloc
-#include <sys/stat.h>
-#include <sys/types.h>
-#include <unistd.h>
-
-#include "rpc_messages.pb.h"
-
-#define ONE_KB (0x400)
-#define ONE_MB (ONE_KB * ONE_KB)
-#define PAGESIZE (ONE_MB)
-#define ADDRBITS (20)
-#define N_1MBARRAYS 4096
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
+// Device memory model used when hw_emu runs without a simulator
+// connection.
+//
+// Each memory bank is backed by one sparse file that is memory mapped
+// in full.  Pages are allocated by the kernel on first touch, so only
+// memory that is accessed consumes host memory, and a device address
+// translates to a host address with one lookup of the bank followed
+// by pointer arithmetic.  Transfers within a bank are a single
+// memcpy regardless of size.
+//
+// Addresses outside of the known banks are backed by regions of
+// fixed size created on demand.  The files persist after the model
+// is destroyed.
 class mem_model{
 public:
-unsigned int writeDevMem(uint64_t offset, const void* src, unsigned int size);
-unsigned int readDevMem(uint64_t offset, void* dest, unsigned int size);
+  // Address range of a memory bank, size in bytes
+  struct bank
+  {
+    uint64_t base_addr;
+    uint64_t size;
+  };
+
+  unsigned int writeDevMem(uint64_t offset, const void* src, unsigned int size);
+  unsigned int readDevMem(uint64_t offset, void* dest, unsigned int size);
 
-protected:
 private:
-  unsigned char* get_page(uint64_t offset);
-  std::string get_mem_file_name(uint64_t pageIdx);
-  std::map<uint64_t,unsigned char*> pageCache;
-  std::map<uint64_t,unsigned char*>::iterator pageCacheItr;
-
-  ddr_mem_msg serialize_msg;
-  ddr_mem_msg deserialize_msg;
-  void serialize();
+  // Size of regions created for addresses outside of known banks
+  static constexpr uint64_t default_region_size = 0x40000000; // 1GB
+
+  struct region
+  {
+    uint64_t base_addr;
+    uint64_t size;
+    unsigned char* data;
+  };
+
+  region* get_region(uint64_t addr);
+  region* map_region(uint64_t base_addr, uint64_t size);
+  std::string get_mem_file_name(uint64_t base_addr);
+
+  std::mutex mMutex;
+  std::map<uint64_t, region> mRegions;   // base address -> region
+  std::vector<bank> mBanks;              // merged, sorted by address
+
   std::string mDeviceName;
   std::string module_name;
 public:
-  mem_model(std::string deviceName);
+  mem_model(std::string deviceName, std::vector<bank> banks = {});
   ~ mem_model();
+
+  mem_model(const mem_model&) = delete;
+  mem_model& operator=(const mem_model&) = delete;
 };
 
 #endif
-
-
@@ -1469,12 +1469,23 @@ namespace xclhwemhal2 {
     return 1;
   }
 
+  // Memory model backed by one mapped file per memory bank of the
+  // loaded xclbin
+  mem_model* HwEmShim::createMemModel()
+  {
+    std::vector<mem_model::bank> banks;
+    banks.reserve(mMembanks.size());
+    for (const auto& mb : mMembanks)
+      banks.push_back({mb.base_addr, mb.size});
+    return new mem_model(deviceName, std::move(banks));
+  }
+
   size_t HwEmShim::xclCopyBufferHost2Device(uint64_t dest, const void *src, size_t size, size_t seek, uint32_t topology)
   {
     if (!sock)
     {
       if (!mMemModel)
-        mMemModel = new mem_model(deviceName);
+        mMemModel = createMemModel();
       mMemModel->writeDevMem(dest, src, size);
       return size;
     }
@@ -1544,7 +1555,7 @@ namespace xclhwemhal2 {
     if(!sock)
     {
       if(!mMemModel)
-        mMemModel = new mem_model(deviceName);
+        mMemModel = createMemModel();
       mMemModel->readDevMem(src,dest,size);
       return size;
     }
@@ -392,6 +392,7 @@ using addr_type = uint64_t;
       void xclFreeDeviceBuffer(uint64_t buf,bool sendtosim);
       size_t xclCopyBufferHost2Device(uint64_t dest, const void *src, size_t size, size_t seek, uint32_t topology);
       size_t xclCopyBufferDevice2Host(void *dest, uint64_t src, size_t size, size_t skip, uint32_t topology);
+      mem_model* createMemModel();
       void xclClose(bool DonotRunParseLog = false);
       unsigned int xclProbe();
 
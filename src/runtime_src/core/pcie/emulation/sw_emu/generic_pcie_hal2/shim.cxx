@@ -100,6 +100,8 @@ namespace xclswemuhal2
     bUnified = _unified;
     bXPR = _xpr;
     mIsKdsSwEmu = (xclemulation::is_sw_emulation()) ? xrt_core::config::get_flag_kds_sw_emu() : false;
+    // The data plane relies on the single mmap layout where file offset is device address
+    mSharedDataPlane = xrt_core::config::get_sw_emu_shared_memory() && !std::getenv("VITIS_SW_EMU_DISABLE_SINGLE_MMAP");
   }
 
   size_t SwEmuShim::alloc_void(size_t new_size)
@@ -909,6 +911,7 @@ namespace xclswemuhal2
         i->free(offset);
       }
     }
+    removeSharedRange(offset);
     bool ack = true;
     if (sock)
     {
@@ -1099,6 +1102,76 @@ namespace xclswemuhal2
     return size;
   }
 
+  void SwEmuShim::addSharedRange(uint64_t base, uint64_t size, const std::string& filename)
+  {
+    if (!mSharedDataPlane || filename.empty())
+      return;
+
+    std::lock_guard lk(mSharedRangesMtx);
+    mSharedRanges[base] = {size, filename, nullptr};
+  }
+
+  void SwEmuShim::removeSharedRange(uint64_t base)
+  {
+    std::lock_guard lk(mSharedRangesMtx);
+    auto it = mSharedRanges.find(base);
+    if (it == mSharedRanges.end())
+      return;
+
+    auto& range = (*it).second;
+    if (range.data)
+    {
+      auto pageOffset = base % getpagesize();
+      munmap(range.data - pageOffset, range.size + pageOffset);
+    }
+    mSharedRanges.erase(it);
+  }
+
+  // Return host address of device range [addr, addr+size) if the range
+  // is within a buffer backed by shared memory, nullptr otherwise in
+  // which case the transfer must go through the device process.
+  char* SwEmuShim::getSharedAddress(uint64_t addr, size_t size)
+  {
+    if (!mSharedDataPlane)
+      return nullptr;
+
+    std::lock_guard lk(mSharedRangesMtx);
+    auto it = mSharedRanges.upper_bound(addr);
+    if (it == mSharedRanges.begin())
+      return nullptr;
+
+    --it;
+    auto base = (*it).first;
+    auto& range = (*it).second;
+    if (addr + size > base + range.size)
+      return nullptr;
+
+    if (!range.data)
+    {
+      int fd = open(range.filename.c_str(), O_RDWR);
+      if (fd == -1)
+      {
+        mSharedRanges.erase(it);
+        return nullptr;
+      }
+
+      // mmap offset must be page aligned
+      auto pageOffset = base % getpagesize();
+      void* data = mmap(0, range.size + pageOffset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, base - pageOffset);
+      close(fd);
+      if (data == MAP_FAILED)
+      {
+        if (mLogStream.is_open())
+          mLogStream << __func__ << ", failed to map " << range.filename << " at " << std::hex << base << std::dec << std::endl;
+        mSharedRanges.erase(it);
+        return nullptr;
+      }
+      range.data = static_cast<char*>(data) + pageOffset;
+    }
+
+    return range.data + (addr - base);
+  }
+
   size_t SwEmuShim::xclCopyBufferHost2Device(uint64_t dest, const void *src, size_t size, size_t seek)
   {
     if (mLogStream.is_open())
@@ -1115,6 +1188,14 @@ namespace xclswemuhal2
     src = (unsigned char *)src + seek;
     dest += seek;
 
+    if (auto shared = getSharedAddress(dest, size))
+    {
+      if (shared != src)
+        std::memcpy(shared, src, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1160,6 +1241,15 @@ namespace xclswemuhal2
       launchTempProcess();
 
     src += skip;
+
+    if (auto shared = getSharedAddress(src, size))
+    {
+      if (shared != dest)
+        std::memcpy(dest, shared, size);
+      DEBUG_MSGS("%s, %d(ENDED shared memory)\n", __func__, __LINE__);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -1523,6 +1613,9 @@ namespace xclswemuhal2
       return xclemulation::MemoryManager::mNull;
     }
 
+    if (zeroCopy)
+      addSharedRange(xobj->base, size, sFileName);
+
     info->handle = mBufferCount;
 
     if (mLogStream.is_open())
@@ -1943,6 +2036,13 @@ namespace xclswemuhal2
       return -1;
     }
 
+    // A mapped zero copy buffer is the shared device memory itself
+    if (mSharedDataPlane && xclemulation::is_zero_copy(bo) && !bo->userptr && bo->buf)
+    {
+      PRINTENDFUNC;
+      return 0;
+    }
+
     int returnVal = 0;
     if (dir == XCL_BO_SYNC_BO_TO_DEVICE)
     {
@@ -824,6 +824,26 @@ namespace xclswemuhal2
     static unsigned int mBufferCount;
     static std::map<int, std::tuple<std::string, uint64_t, void *>> mFdToFileNameMap;
     // HAL2 RELATED member variables end
+
+    // Shared memory data plane.  Zero copy buffers are backed by a
+    // file shared with the device process, the file offset is the
+    // device address.  Transfers to and from such buffers are done
+    // by memcpy through a host mapping of the file, and only control
+    // messages go over the socket.  Ranges are keyed by device address
+    // and mapped on first transfer.
+    struct shared_range
+    {
+      uint64_t size;
+      std::string filename;
+      char* data;
+    };
+    std::map<uint64_t, shared_range> mSharedRanges;
+    std::mutex mSharedRangesMtx;
+    bool mSharedDataPlane;
+
+    void addSharedRange(uint64_t base, uint64_t size, const std::string& filename);
+    void removeSharedRange(uint64_t base);
+    char* getSharedAddress(uint64_t addr, size_t size);
     std::list<std::tuple<uint64_t, void *, std::map<uint64_t, uint64_t>>> mReqList;
     uint64_t mReqCounter;
     FeatureRomHeader mFeatureRom;
@@ -5,6 +5,7 @@
 // Local - Include Files
 #include "TestRunner.h"
 #include "tests/TestValidateUtilities.h"
+#include "core/common/api/command_trace.h"
 #include "core/common/error.h"
 #include "core/common/module_loader.h"
 #include "core/common/archive.h"
@@ -52,6 +53,18 @@ runTestInternal(const std::shared_ptr<xrt_core::device>& dev,
   is_thread_running = false;
 }
 
+// Log host side latency of commands executed by the test, enabled
+// with xrt.ini Runtime.command_trace=true
+static void
+log_command_trace(boost::property_tree::ptree& ptree)
+{
+  auto records = xrt_core::command_trace::get_records();
+  if (records.empty())
+    return;
+
+  XBValidateUtils::logger(ptree, "Command trace", xrt_core::command_trace::summary(records));
+}
+
 } //end anonymous namespace
 
 // ----- C L A S S   M E T H O D S -------------------------------------------
@@ -77,6 +90,9 @@ TestRunner::startTest(const std::shared_ptr<xrt_core::device>& dev, const xrt_co
   bool is_thread_running = true;
 
   boost::property_tree::ptree result;
+  bool command_trace = xrt_core::command_trace::enabled();
+  if (command_trace)
+    xrt_core::command_trace::clear();
 
   // Start the test process
   std::thread test_thread([&] { runTestInternal(dev, result, this, is_thread_running, archive); });
@@ -99,6 +115,9 @@ TestRunner::startTest(const std::shared_ptr<xrt_core::device>& dev, const xrt_co
   test_thread.join();
   busy_bar.finish();
 
+  if (command_trace)
+    log_command_trace(result);
+
   return result;
 }
 
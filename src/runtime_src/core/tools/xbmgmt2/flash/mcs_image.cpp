@@ -0,0 +1,308 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#include "mcs_image.h"
+#include "core/common/error.h"
+
+#include <array>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64)
+# include <emmintrin.h>
+# define XBMGMT_MCS_SSE2
+#endif
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace {
+
+// Record types in Xilinx MCS files
+constexpr uint8_t record_data = 0x00;
+constexpr uint8_t record_eof = 0x01;
+constexpr uint8_t record_ela = 0x04;
+
+// Value of hex digit, or 0xff if not a hex digit
+static std::array<uint8_t, 256>
+make_hex_table()
+{
+  std::array<uint8_t, 256> table {};
+  table.fill(0xff);
+  for (int ch = '0'; ch <= '9'; ++ch)
+    table[ch] = static_cast<uint8_t>(ch - '0');
+  for (int ch = 'a'; ch <= 'f'; ++ch)
+    table[ch] = table[ch - 'a' + 'A'] = static_cast<uint8_t>(ch - 'a' + 10);
+  return table;
+}
+
+#ifdef XBMGMT_MCS_SSE2
+// Decode 16 hex digits into 8 bytes and add the bytes to sum, return
+// false if any character is not a hex digit
+static bool
+decode_hex16(const char* in, unsigned char* out, unsigned int& sum)
+{
+  auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+
+  // '0'-'9', signed compare rejects characters >= 0x80
+  auto digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                             _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+
+  // 'a'-'f' after folding 'A'-'F' to lower case
+  auto lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+  auto alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                             _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+  if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xffff)
+    return false;
+
+  auto nibble = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(v, _mm_set1_epi8('0'))),
+                             _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+  // High nibble is in even byte, low nibble in odd byte of each word
+  auto word = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibble, _mm_set1_epi16(0x00ff)), 4),
+                           _mm_srli_epi16(nibble, 8));
+  auto bytes = _mm_packus_epi16(word, word);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+
+  // Horizontal sum of the low 8 bytes
+  sum += _mm_cvtsi128_si32(_mm_sad_epu8(_mm_unpacklo_epi64(bytes, _mm_setzero_si128()), _mm_setzero_si128()));
+  return true;
+}
+#endif
+
+// Decode 2 * count hex digits into count bytes and add the bytes to
+// sum, return false if any character is not a hex digit
+static bool
+decode_hex(const char* in, size_t count, unsigned char* out, unsigned int& sum)
+{
+#ifdef XBMGMT_MCS_SSE2
+  for (; count >= 8; count -= 8, in += 16, out += 8)
+    if (!decode_hex16(in, out, sum))
+      return false;
+#endif
+
+  static const auto table = make_hex_table();
+  uint8_t invalid = 0;
+  for (; count; --count, in += 2, ++out) {
+    auto hi = table[static_cast<uint8_t>(in[0])];
+    auto lo = table[static_cast<uint8_t>(in[1])];
+    invalid |= hi | lo;
+    *out = static_cast<unsigned char>((hi << 4) | (lo & 0xf));
+    sum += *out;
+  }
+  return (invalid & 0xf0) == 0;
+}
+
+[[noreturn]] static void
+invalid(size_t line, const std::string& msg)
+{
+  throw xrt_core::error(EINVAL, "Invalid MCS record at line " + std::to_string(line) + ": " + msg);
+}
+
+static std::string
+read_stream(std::istream& stream)
+{
+  std::string text;
+  stream.clear();
+  stream.seekg(0, std::ios_base::end);
+  auto size = stream.tellg();
+  stream.seekg(0, std::ios_base::beg);
+  if (size > 0) {
+    text.resize(static_cast<size_t>(size));
+    stream.read(text.data(), size);
+    text.resize(static_cast<size_t>(stream.gcount()));
+  }
+  else {
+    text.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  }
+  stream.clear();
+  stream.seekg(0, std::ios_base::beg);
+  return text;
+}
+
+} // namespace
+
+mcs_image::
+mcs_image(const char* text, size_t size)
+{
+  decode(text, size);
+}
+
+mcs_image::
+mcs_image(std::istream& stream)
+{
+  auto text = read_stream(stream);
+  decode(text.data(), text.size());
+}
+
+mcs_image
+mcs_image::
+from_file(const std::string& path)
+{
+  mcs_image image;
+#ifdef _WIN32
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs)
+    throw xrt_core::error(ENOENT, "Unable to open MCS file '" + path + "'");
+  image = mcs_image(ifs);
+#else
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw xrt_core::error(errno, "Unable to open MCS file '" + path + "'");
+
+  struct stat st {};
+  if (::fstat(fd, &st) || st.st_size == 0) {
+    ::close(fd);
+    image.decode(nullptr, 0);
+    return image;
+  }
+
+  auto addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED)
+    throw xrt_core::error(errno, "Unable to map MCS file '" + path + "'");
+
+  try {
+    image.decode(static_cast<const char*>(addr), st.st_size);
+  }
+  catch (...) {
+    ::munmap(addr, st.st_size);
+    throw;
+  }
+  ::munmap(addr, st.st_size);
+#endif
+  return image;
+}
+
+size_t
+mcs_image::
+get_size() const
+{
+  return std::accumulate(m_segments.begin(), m_segments.end(), size_t(0),
+                         [](size_t sz, const segment& seg) { return sz + seg.data.size(); });
+}
+
+void
+mcs_image::
+decode(const char* text, size_t size)
+{
+  const char* itr = text;
+  const char* end = text + size;
+  size_t line = 1;
+
+  uint64_t ela = 0;            // current extended linear address
+  bool have_ela = false;       // extended linear address seen
+  bool new_segment = true;     // next data starts a new segment
+  bool first_data = false;     // next data is first after extended address
+  bool eof = false;            // end of file record seen
+  std::array<unsigned char, 255> rec;
+
+  while (!eof) {
+    // Records are separated by line breaks
+    for (; itr != end && (*itr == '\n' || *itr == '\r' || *itr == ' ' || *itr == '\t'); ++itr)
+      if (*itr == '\n')
+        ++line;
+
+    if (itr == end)
+      break;
+
+    if (*itr != ':')
+      invalid(line, "missing start code ':'");
+
+    // Header is length, address, and type bytes
+    unsigned int sum = 0;
+    std::array<unsigned char, 4> hdr;
+    if (end - itr < 9 || !decode_hex(itr + 1, hdr.size(), hdr.data(), sum))
+      invalid(line, "bad record header");
+
+    size_t len = hdr[0];
+    uint64_t offset = (hdr[1] << 8) | hdr[2];
+    auto type = hdr[3];
+
+    // Data and checksum byte follow the header
+    const char* hex = itr + 9;
+    if (static_cast<size_t>(end - hex) < 2 * (len + 1))
+      invalid(line, "truncated record");
+    itr = hex + 2 * (len + 1);
+
+    // Data records are decoded directly into their segment
+    unsigned char* data = rec.data();
+    if (type == record_data) {
+      if (!have_ela)
+        invalid(line, "data record before extended linear address");
+
+      // An extended linear address contiguous with the current segment
+      // can still start its data at a non-zero offset
+      if (first_data && !new_segment) {
+        auto& seg = m_segments.back();
+        new_segment = (seg.address + seg.data.size() != ela + offset);
+      }
+      first_data = false;
+
+      if (new_segment) {
+        // Reserve for remaining text, 16 bytes per 43 characters, and
+        // release the unused reservation of the completed segment
+        if (!m_segments.empty())
+          m_segments.back().data.shrink_to_fit();
+        m_segments.push_back({static_cast<uint32_t>(ela + offset), {}});
+        m_segments.back().data.reserve(static_cast<size_t>(end - itr) / 43 * 16 + len);
+        new_segment = false;
+      }
+
+      auto& seg = m_segments.back();
+      if (seg.address + seg.data.size() != ela + offset)
+        invalid(line, "data address is not contiguous");
+
+      seg.data.resize(seg.data.size() + len);
+      data = seg.data.data() + seg.data.size() - len;
+    }
+
+    unsigned char checksum = 0;
+    if (!decode_hex(hex, len, data, sum) || !decode_hex(hex + 2 * len, 1, &checksum, sum))
+      invalid(line, "bad hex digit");
+
+    // Sum of all bytes including the checksum is 0
+    if (sum & 0xff)
+      invalid(line, "checksum mismatch");
+
+    switch (type) {
+    case record_data:
+      break;
+    case record_eof:
+      eof = true;
+      break;
+    case record_ela:
+    {
+      if (len != 2 || offset != 0)
+        invalid(line, "bad extended linear address record");
+
+      ela = static_cast<uint64_t>((data[0] << 8) | data[1]) << 16;
+      if (!have_ela)
+        m_golden = (ela == 0);
+      have_ela = true;
+      first_data = true;
+
+      // Continue current segment if address is contiguous
+      new_segment = m_segments.empty()
+        || m_segments.back().address + m_segments.back().data.size() != ela;
+      break;
+    }
+    default:
+      invalid(line, "unsupported record type " + std::to_string(type));
+    }
+  }
+
+  if (!eof)
+    invalid(line, "missing end of file record");
+
+  if (m_segments.empty())
+    invalid(line, "no data records");
+
+  m_segments.back().data.shrink_to_fit();
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XBMGMT_FLASH_MCS_IMAGE_H
+#define XBMGMT_FLASH_MCS_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// class mcs_image - Flash image decoded from MCS (Intel hex) text
+//
+// The text is decoded in one pass into contiguous segments of binary
+// data, each starting at a flash address.  Hex digits are decoded 16
+// at a time with SSE2 where available, and the checksum of every
+// record is verified.  A flasher decodes each image once, before
+// touching the flash, and erases and programs from the segments.
+//
+// Only the record types used by Xilinx MCS files are accepted: data
+// (00), end of file (01), and extended linear address (04).  Data
+// within an extended linear address must be contiguous, data that is
+// not contiguous with a previous extended linear address starts a new
+// segment.  Invalid or truncated text throws xrt_core::error.
+class mcs_image
+{
+public:
+  // struct segment - Contiguous flash data starting at address
+  struct segment
+  {
+    uint32_t address;
+    std::vector<unsigned char> data;
+  };
+
+  // Decode MCS text of size bytes
+  mcs_image(const char* text, size_t size);
+
+  // Decode MCS text of stream, the stream is rewound after reading
+  explicit
+  mcs_image(std::istream& stream);
+
+  // from_file() - Decode MCS file, the file is memory mapped
+  static mcs_image
+  from_file(const std::string& path);
+
+  const std::vector<segment>&
+  get_segments() const
+  {
+    return m_segments;
+  }
+
+  // get_size() - Total number of data bytes in all segments
+  size_t
+  get_size() const;
+
+  // is_golden() - Check if first extended linear address is 0
+  //
+  // A golden image is written to the start of flash and is not
+  // protected by a bitstream guard.
+  bool
+  is_golden() const
+  {
+    return m_golden;
+  }
+
+private:
+  std::vector<segment> m_segments;
+  bool m_golden = false;
+
+  mcs_image() = default;
+
+  void
+  decode(const char* text, size_t size);
+};
+
+#endif
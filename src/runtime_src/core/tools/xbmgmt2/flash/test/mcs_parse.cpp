@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Benchmark for decoding MCS flash images, no device is required
+//
+// % cmake -B build -DXILINX_XRT=<path>
+// % cmake --build build --config <Release|Debug>
+//
+// Decode an MCS file 10 times and write the binary image
+// % <path>/mcs_parse -f primary.mcs -i 10 -o primary.bin
+//
+// Decode a 128MB image generated in memory
+// % <path>/mcs_parse -g 128
+//
+// The benchmark measures mcs_image::from_file(), which maps the file
+// and decodes it into contiguous segments of binary data, against a
+// line by line decoder equivalent to what xbmgmt used before.  A
+// generated image is never written to disk, it is decoded from memory
+// with the mcs_image text constructor.  The binary image written with
+// -o has one segment after another, each segment is reported with its
+// flash address.
+
+#include "core/tools/xbmgmt2/flash/mcs_image.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: mcs_parse [options]\n"
+            << " [-f <file>] MCS file to decode\n"
+            << " [-g <MB>] generate MCS image of size MB in memory instead of reading file (default 64)\n"
+            << " [-i <iterations>] number of times to decode (default 5)\n"
+            << " [-o <file>] write decoded binary image to file\n";
+}
+
+static std::string
+make_record(unsigned int type, unsigned int address, const unsigned char* data, size_t len)
+{
+  unsigned int sum = len + (address >> 8) + (address & 0xff) + type;
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), ":%02X%04X%02X", static_cast<unsigned int>(len), address & 0xffff, type);
+  std::string rec = buf;
+  for (size_t idx = 0; idx < len; ++idx) {
+    std::snprintf(buf, sizeof(buf), "%02X", data[idx]);
+    rec += buf;
+    sum += data[idx];
+  }
+  std::snprintf(buf, sizeof(buf), "%02X\n", (0x100 - (sum & 0xff)) & 0xff);
+  return rec + buf;
+}
+
+// MCS text of random data starting at a non golden address
+static std::string
+generate(size_t megabytes)
+{
+  std::mt19937 gen(0);
+  std::string text;
+  unsigned int address = 0x01000000;
+  unsigned char data[16];
+  for (size_t size = 0; size < megabytes << 20; size += sizeof(data), address += sizeof(data)) {
+    if ((address & 0xffff) == 0) {
+      unsigned char ela[2] = {static_cast<unsigned char>(address >> 24), static_cast<unsigned char>(address >> 16)};
+      text += make_record(4, 0, ela, sizeof(ela));
+    }
+    for (auto& byte : data)
+      byte = static_cast<unsigned char>(gen());
+    text += make_record(0, address, data, sizeof(data));
+  }
+  return text + make_record(1, 0, nullptr, 0);
+}
+
+// Line by line decoding as done by xbmgmt before mcs_image, returns
+// number of data bytes
+static size_t
+decode_lines(std::istream& stream)
+{
+  std::vector<unsigned char> buf;
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.empty())
+      continue;
+    auto len = std::stoi(line.substr(1, 2), nullptr, 16);
+    auto type = std::stoi(line.substr(7, 2), nullptr, 16);
+    if (type == 1)
+      break;
+    if (type != 0)
+      continue;
+    auto data = line.substr(9, len * 2);
+    for (size_t idx = 0; idx < data.size(); idx += 2)
+      buf.push_back(static_cast<unsigned char>(std::stoi(data.substr(idx, 2), nullptr, 16)));
+  }
+  return buf.size();
+}
+
+template <typename Function>
+static double
+seconds(Function&& f)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  std::string file;
+  std::string output;
+  size_t megabytes = 64;       // NOLINT
+  size_t iterations = 5;       // NOLINT
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-f")
+      file = arg;
+    else if (cur == "-g")
+      megabytes = std::stoul(arg);
+    else if (cur == "-i")
+      iterations = std::stoul(arg);
+    else if (cur == "-o")
+      output = arg;
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  std::stringstream text;
+  if (file.empty()) {
+    text.str(generate(megabytes));
+    std::cout << "generated " << megabytes << "MB image\n";
+  }
+  else {
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs)
+      throw std::runtime_error("Unable to open " + file);
+    text << ifs.rdbuf();
+  }
+  const auto str = text.str();
+  auto text_size = static_cast<double>(str.size());
+
+  // Decode mapped file, or generated text in memory
+  auto decode = [&] {
+    return file.empty() ? mcs_image(str.data(), str.size()) : mcs_image::from_file(file);
+  };
+
+  // Best of iterations for each decoder
+  double lines = 0;
+  size_t lines_size = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    text.clear();
+    text.seekg(0);
+    auto t = seconds([&] { lines_size = decode_lines(text); });
+    lines = i ? std::min(lines, t) : t;
+  }
+
+  double image = 0;
+  size_t image_size = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    auto t = seconds([&] { image_size = decode().get_size(); });
+    image = i ? std::min(image, t) : t;
+  }
+
+  if (lines_size != image_size)
+    throw std::runtime_error("decoders differ, " + std::to_string(lines_size)
+                             + " vs " + std::to_string(image_size) + " bytes");
+
+  std::cout << "decoded " << image_size << " bytes from " << static_cast<size_t>(text_size) << " bytes of text\n"
+            << "line by line: " << lines * 1000 << " ms, " << text_size / lines / (1 << 20) << " MB/s\n"
+            << "mcs_image:    " << image * 1000 << " ms, " << text_size / image / (1 << 20) << " MB/s\n";
+
+  if (output.empty())
+    return;
+
+  auto decoded = decode();
+  std::ofstream ofs(output, std::ios::binary | std::ios::trunc);
+  for (const auto& segment : decoded.get_segments()) {
+    std::cout << "segment @0x" << std::hex << segment.address << std::dec
+              << ": " << segment.data.size() << " bytes\n";
+    ofs.write(reinterpret_cast<const char*>(segment.data.data()), static_cast<std::streamsize>(segment.data.size()));
+  }
+  if (!ofs)
+    throw std::runtime_error("Unable to write " + output);
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
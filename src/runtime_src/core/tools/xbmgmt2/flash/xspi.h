@@ -21,6 +21,7 @@
 #include <iostream>
 #include "core/common/system.h"
 #include "core/common/device.h"
+#include "mcs_image.h"
 
 class XSPI_Flasher
 {
@@ -29,9 +30,9 @@ class XSPI_Flasher
     unsigned int mStartAddress;
     unsigned int mEndAddress;
     unsigned int mDataCount;
-    std::streampos mDataPos;
+    const unsigned char* mData;
 
-    ELARecord() : mStartAddress(0), mEndAddress(0), mDataCount(0), mDataPos(0) {}
+    ELARecord() : mStartAddress(0), mEndAddress(0), mDataCount(0), mData(nullptr) {}
   };
 
   typedef std::list<ELARecord> ELARecordList;
@@ -48,7 +49,7 @@ class XSPI_Flasher
   std::shared_ptr<xrt_core::device> mDev;
   std::FILE *mFlashDev = nullptr;
 
-  int parseMCS(std::istream& mcsStream);
+  int parseMCS(const mcs_image& image);
 
   unsigned long long flash_base;
   int xclTestXSpi(int device_index);
@@ -67,16 +68,16 @@ class XSPI_Flasher
   bool writePage(unsigned int addr, uint8_t writeCmd = 0xff);
   bool readPage(unsigned int addr, uint8_t readCmd = 0xff);
   bool prepareXSpi(uint8_t slave_sel);
-  int programRecord(std::istream& mcsStream, const ELARecord& record);
-  int programXSpi(std::istream& mcsStream, uint32_t bitstream_shift_addr);
+  int programRecord(const ELARecord& record);
+  int programXSpi(uint32_t bitstream_shift_addr);
   bool readRegister(uint8_t commandCode, unsigned int bytes);
   bool writeRegister(uint8_t commandCode, unsigned int value, unsigned int bytes);
   bool setSector(unsigned int address);
   unsigned int getSector(unsigned int address);
 
   // Upgrade firmware via driver.
-  int upgradeFirmware1Drv(std::istream& mcsStream1, std::istream& stripped);
-  int upgradeFirmware2Drv(std::istream& mcsStream1, std::istream& mcsStream2, std::istream& stripped);
+  int upgradeFirmware1Drv(const mcs_image& image, std::istream& stripped);
+  int upgradeFirmware2Drv(const mcs_image& image1, const mcs_image& image2, std::istream& stripped);
 
   int xclReadData(std::vector<unsigned char>& data);
   int xclWriteData(const std::vector<unsigned char>& data);
@@ -23,6 +23,8 @@ usage(const char* cmd) {
   std::cout << "\t-h|--help Print usage" << std::endl;
   std::cout << "\t-v|--verbose turn on printing verbosely" << std::endl;
   std::cout << "\t-o|--out_dir output directory which holds trace output files" << std::endl;
+  std::cout << "\t-c|--chunk_size <bytes> chunk size used to deduplicate buffer data in the blob file," << std::endl;
+  std::cout << "\t                        0 stores buffer data inline in the trace file" << std::endl;
 }
 
 // NOLINTBEGIN(*-avoid-c-arrays)
@@ -51,6 +53,9 @@ parse_args(struct tracer_arg &args, int argc, const char* argv[])
     else if ((!got_app) && (arg_str == "-o" || arg_str == "--out_dir")) {
       args.out_dir = argv[++i];
     }
+    else if ((!got_app) && (arg_str == "-c" || arg_str == "--chunk_size")) {
+      args.chunk_size = argv[++i];
+    }
     else if (!got_app && argv[i][0] == '-') {
       std::cerr << "ERROR: xbtracer: unsuppocrted argument: " + arg_str << std::endl;
       return -EINVAL;
@@ -111,6 +116,11 @@ init_tracer(const struct tracer_arg &args)
     return -EINVAL;
   }
   xbtracer_pinfo("tracer output to directory \"", opath.string(), "\".");
+
+  if (!args.chunk_size.empty() && setenv_os("XBTRACER_BLOB_CHUNK_SIZE", args.chunk_size.c_str())) {
+    xbtracer_perror("failed to set tracer blob chunk size \"", args.chunk_size, "\".");
+    return -EINVAL;
+  }
   return 0;
 }
 
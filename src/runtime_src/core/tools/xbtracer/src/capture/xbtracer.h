@@ -20,6 +20,7 @@ struct tracer_arg {
   bool verbose;
   std::vector<std::string> target_app;
   std::string out_dir;
+  std::string chunk_size;
 };
 
 int launch_app(const struct tracer_arg &arg);
@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include "common/trace_blob.h"
+#include "common/trace_utils.h"
+
+namespace
+{
+
+constexpr std::array<char, 8> blob_magic = {'X', 'B', 'T', 'B', 'L', 'O', 'B', '1'};
+
+constexpr uint64_t prime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t prime3 = 0x165667b19e3779f9ULL;
+
+inline uint64_t
+rotl(uint64_t v, int r)
+{
+  return (v << r) | (v >> (64 - r));
+}
+
+inline uint64_t
+mix(uint64_t acc, uint64_t v)
+{
+  acc += v * prime2;
+  acc = rotl(acc, 31);
+  return acc * prime1;
+}
+
+inline uint64_t
+avalanche(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+} // namespace
+
+namespace xrt::tools::xbtracer
+{
+
+// Two independent 64-bit lanes over 8-byte words.  Not cryptographic,
+// but 128 bits makes accidental collisions between chunks of a trace
+// practically impossible.
+blob_hash
+blob_compute_hash(const void* data, size_t size)
+{
+  auto bytes = static_cast<const char*>(data);
+  uint64_t h1 = prime3 ^ size;
+  uint64_t h2 = prime1 + size;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) * 2 <= size; i += sizeof(uint64_t) * 2) {
+    uint64_t w1 = 0;
+    uint64_t w2 = 0;
+    std::memcpy(&w1, bytes + i, sizeof(w1));
+    std::memcpy(&w2, bytes + i + sizeof(w1), sizeof(w2));
+    h1 = mix(h1, w1);
+    h2 = mix(h2, w2 ^ w1);
+  }
+  for (; i < size; ++i) {
+    h1 = mix(h1, static_cast<unsigned char>(bytes[i]));
+    h2 = mix(h2, static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << 7);
+  }
+  return {avalanche(h1 ^ rotl(h2, 17)), avalanche(h2 ^ rotl(h1, 29))};
+}
+
+std::string
+blob_file_name_from_trace(const std::string& trace_file)
+{
+  std::filesystem::path p(trace_file);
+  p.replace_extension(".blob");
+  return p.string();
+}
+
+blob_writer::
+blob_writer(const std::string& fname, uint32_t csize)
+  : ofile(fname, std::ios::out | std::ios::binary | std::ios::trunc)
+  , chunk_size(csize)
+{
+  if (!ofile.is_open())
+    throw std::runtime_error("xbtracer failed to open blob file: \"" + fname + "\".");
+  if (!chunk_size)
+    throw std::runtime_error("xbtracer invalid blob chunk size 0.");
+  ofile.write(blob_magic.data(), blob_magic.size());
+}
+
+blob_writer::
+~blob_writer()
+{
+  if (ofile.is_open())
+    ofile.close();
+}
+
+void
+blob_writer::
+write_chunk_nolock(const blob_hash& hash, const char* data, uint32_t size)
+{
+  ofile.write(reinterpret_cast<const char*>(&hash.lo), sizeof(hash.lo));
+  ofile.write(reinterpret_cast<const char*>(&hash.hi), sizeof(hash.hi));
+  ofile.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  ofile.write(data, size);
+  stored_bytes += size;
+}
+
+blob_writer::snapshot
+blob_writer::
+add_nolock(const void* data, size_t size, const buffer_key* key)
+{
+  auto bytes = static_cast<const char*>(data);
+  snapshot snap;
+  snap.chunk_size = chunk_size;
+  snap.total_size = size;
+  referenced_bytes += size;
+
+  size_t nchunks = (size + chunk_size - 1) / chunk_size;
+  std::vector<blob_hash> hashes;
+  hashes.reserve(nchunks);
+  for (size_t idx = 0; idx < nchunks; ++idx) {
+    size_t offset = idx * chunk_size;
+    auto csize = static_cast<uint32_t>(std::min<size_t>(chunk_size, size - offset));
+    auto hash = blob_compute_hash(bytes + offset, csize);
+    if (chunks.emplace(hash, csize).second)
+      write_chunk_nolock(hash, bytes + offset, csize);
+    hashes.push_back(hash);
+  }
+
+  const std::vector<blob_hash>* base = nullptr;
+  if (key) {
+    snap.id = next_snapshot_id++;
+    auto it = last_snapshots.find(*key);
+    if (it != last_snapshots.end() && it->second.second.size() == nchunks) {
+      snap.base_id = it->second.first;
+      base = &it->second.second;
+    }
+  }
+
+  for (size_t idx = 0; idx < nchunks; ++idx) {
+    if (base && (*base)[idx] == hashes[idx])
+      continue;
+    snap.chunks.push_back({static_cast<uint32_t>(idx), hashes[idx]});
+  }
+
+  if (key)
+    last_snapshots[*key] = {snap.id, std::move(hashes)};
+
+  return snap;
+}
+
+blob_writer::snapshot
+blob_writer::
+add(const void* data, size_t size, const buffer_key& key)
+{
+  std::lock_guard<std::mutex> lock(mlock);
+  return add_nolock(data, size, &key);
+}
+
+blob_writer::snapshot
+blob_writer::
+add(const void* data, size_t size)
+{
+  std::lock_guard<std::mutex> lock(mlock);
+  return add_nolock(data, size, nullptr);
+}
+
+blob_reader::
+blob_reader(const std::string& fname)
+  : ifile(fname, std::ios::in | std::ios::binary)
+{
+  if (!ifile.is_open())
+    throw std::runtime_error("xbreplay failed to open blob file: \"" + fname + "\".");
+
+  std::array<char, blob_magic.size()> magic{};
+  if (!ifile.read(magic.data(), magic.size()) || magic != blob_magic)
+    throw std::runtime_error("xbreplay invalid blob file: \"" + fname + "\".");
+
+  // Index chunk records, payloads are read on demand
+  while (true) {
+    blob_hash hash;
+    uint32_t size = 0;
+    if (!ifile.read(reinterpret_cast<char*>(&hash.lo), sizeof(hash.lo)) ||
+        !ifile.read(reinterpret_cast<char*>(&hash.hi), sizeof(hash.hi)) ||
+        !ifile.read(reinterpret_cast<char*>(&size), sizeof(size)))
+      break;
+    auto offset = static_cast<uint64_t>(ifile.tellg());
+    index.emplace(hash, std::make_pair(offset, size));
+    ifile.seekg(size, std::ios::cur);
+  }
+  ifile.clear();
+  xbtracer_pinfo("blob file \"", fname, "\" indexed ", index.size(), " chunks.");
+}
+
+int
+blob_reader::
+read_chunk_nolock(const blob_hash& hash, char* buf, uint32_t size)
+{
+  auto it = index.find(hash);
+  if (it == index.end()) {
+    xbtracer_perror("blob chunk ", std::hex, hash.hi, hash.lo, std::dec, " not found.");
+    return -1;
+  }
+  if (it->second.second != size) {
+    xbtracer_perror("blob chunk size mismatched: ", it->second.second, ",", size, ".");
+    return -1;
+  }
+  ifile.seekg(static_cast<std::streamoff>(it->second.first), std::ios::beg);
+  if (!ifile.read(buf, size)) {
+    ifile.clear();
+    xbtracer_perror("failed to read blob chunk of ", size, " bytes.");
+    return -1;
+  }
+  return 0;
+}
+
+bool
+blob_reader::
+has_base(const blob_writer::snapshot& snap)
+{
+  if (!snap.base_id)
+    return true;
+
+  std::lock_guard<std::mutex> lock(mlock);
+  return snapshots.find(snap.base_id) != snapshots.end();
+}
+
+int
+blob_reader::
+expand(blob_writer::snapshot& snap)
+{
+  if (!snap.chunk_size) {
+    xbtracer_perror("invalid blob snapshot ", snap.id, ", chunk size 0.");
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(mlock);
+  size_t nchunks = (snap.total_size + snap.chunk_size - 1) / snap.chunk_size;
+  std::vector<blob_hash> hashes;
+  if (snap.base_id) {
+    auto it = snapshots.find(snap.base_id);
+    if (it == snapshots.end() || it->second.size() != nchunks) {
+      xbtracer_perror("blob snapshot ", snap.id, " refers to unknown base ", snap.base_id, ".");
+      return -1;
+    }
+    hashes = std::move(it->second);
+    snapshots.erase(it);
+  }
+  else {
+    if (snap.chunks.size() != nchunks) {
+      xbtracer_perror("blob snapshot ", snap.id, " incomplete, chunks: ", snap.chunks.size(),
+                      ", expected: ", nchunks, ".");
+      return -1;
+    }
+    hashes.resize(nchunks);
+  }
+
+  for (const auto& c : snap.chunks) {
+    if (c.index >= nchunks) {
+      xbtracer_perror("blob snapshot ", snap.id, " invalid chunk index ", c.index, ".");
+      return -1;
+    }
+    hashes[c.index] = c.hash;
+  }
+
+  snap.base_id = 0;
+  snap.chunks.clear();
+  snap.chunks.reserve(nchunks);
+  for (size_t idx = 0; idx < nchunks; ++idx)
+    snap.chunks.push_back({static_cast<uint32_t>(idx), hashes[idx]});
+
+  // Only snapshots of identified buffers can be the base of a later delta
+  if (snap.id)
+    snapshots[snap.id] = std::move(hashes);
+  return 0;
+}
+
+int
+blob_reader::
+read(const blob_writer::snapshot& snap, void* buf, size_t size)
+{
+  if (snap.base_id || size < snap.total_size) {
+    xbtracer_perror("blob snapshot ", snap.id, " cannot be read, base: ", snap.base_id,
+                    ", size: ", snap.total_size, ", buffer: ", size, ".");
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(mlock);
+  auto bytes = static_cast<char*>(buf);
+  for (const auto& c : snap.chunks) {
+    uint64_t offset = static_cast<uint64_t>(c.index) * snap.chunk_size;
+    if (offset >= snap.total_size) {
+      xbtracer_perror("blob snapshot ", snap.id, " invalid chunk index ", c.index, ".");
+      return -1;
+    }
+    auto csize = static_cast<uint32_t>(std::min<uint64_t>(snap.chunk_size, snap.total_size - offset));
+    if (read_chunk_nolock(c.hash, bytes + offset, csize))
+      return -1;
+  }
+  return 0;
+}
+
+} // namespace xrt::tools::xbtracer
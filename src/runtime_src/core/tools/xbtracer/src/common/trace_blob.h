@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef xbtracer_common_trace_blob_h
+#define xbtracer_common_trace_blob_h
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xrt::tools::xbtracer
+{
+
+// Content hash of a chunk of buffer payload.
+struct blob_hash
+{
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  bool
+  operator==(const blob_hash& rhs) const
+  {
+    return lo == rhs.lo && hi == rhs.hi;
+  }
+
+  bool
+  operator!=(const blob_hash& rhs) const
+  {
+    return !(*this == rhs);
+  }
+};
+
+struct blob_hash_hasher
+{
+  size_t
+  operator()(const blob_hash& h) const
+  {
+    return static_cast<size_t>(h.lo ^ (h.hi * 0x9e3779b97f4a7c15ULL));
+  }
+};
+
+blob_hash
+blob_compute_hash(const void* data, size_t size);
+
+// Default chunk size used to split buffer payloads
+inline constexpr uint32_t blob_default_chunk_size = 64 * 1024;
+
+// Payloads smaller than this are stored inline in the trace message
+inline constexpr size_t blob_min_payload_size = 4 * 1024;
+
+// Name of the blob file which goes with a trace file
+std::string
+blob_file_name_from_trace(const std::string& trace_file);
+
+// class blob_writer - append-only, content-addressed chunk store
+//
+// The blob file starts with a magic header followed by records of
+//   [hash_lo (8)][hash_hi (8)][size (4)][data (size)]
+// A chunk is written once no matter how many snapshots refer to it.
+//
+// The writer also remembers the chunk list of the most recent
+// snapshot of each buffer, keyed by caller provided (id, offset), so
+// a new snapshot of the same buffer can be recorded as a delta.
+class blob_writer
+{
+public:
+  struct chunk_ref
+  {
+    uint32_t index;
+    blob_hash hash;
+  };
+
+  struct snapshot
+  {
+    uint64_t id = 0;
+    uint64_t base_id = 0;
+    uint32_t chunk_size = 0;
+    uint64_t total_size = 0;
+    std::vector<chunk_ref> chunks;  // all chunks if base_id == 0, else changed chunks
+  };
+
+  using buffer_key = std::pair<uint64_t, uint64_t>;
+
+  blob_writer(const std::string& fname, uint32_t chunk_size);
+
+  blob_writer(const blob_writer&) = delete;
+  blob_writer& operator=(const blob_writer&) = delete;
+  blob_writer(blob_writer&&) = delete;
+  blob_writer& operator=(blob_writer&&) = delete;
+
+  ~blob_writer();
+
+  // Store payload of a buffer and return the snapshot describing it.
+  snapshot
+  add(const void* data, size_t size, const buffer_key& key);
+
+  // Store payload with no buffer identity, no delta encoding
+  snapshot
+  add(const void* data, size_t size);
+
+  uint64_t
+  get_stored_bytes() const
+  {
+    return stored_bytes;
+  }
+
+  uint64_t
+  get_referenced_bytes() const
+  {
+    return referenced_bytes;
+  }
+
+private:
+  snapshot
+  add_nolock(const void* data, size_t size, const buffer_key* key);
+
+  void
+  write_chunk_nolock(const blob_hash& hash, const char* data, uint32_t size);
+
+  std::mutex mlock;
+  std::ofstream ofile;
+  uint32_t chunk_size;
+  uint64_t next_snapshot_id = 1;
+  uint64_t stored_bytes = 0;
+  uint64_t referenced_bytes = 0;
+  std::unordered_map<blob_hash, uint32_t, blob_hash_hasher> chunks{};
+  std::map<buffer_key, std::pair<uint64_t, std::vector<blob_hash>>> last_snapshots{};
+};
+
+// class blob_reader - resolve snapshots recorded by blob_writer
+//
+// The chunk index is built by scanning record headers when the blob
+// file is opened, payloads are read on demand.
+//
+// expand() turns a delta into a full chunk list using the chunk list
+// of its base.  Snapshot ids are assigned when the payload is stored,
+// but concurrent threads may emit their trace messages in a different
+// order, so a delta can precede its base in the trace.  Use has_base()
+// to defer such a delta until its base has been expanded.  A base is
+// released once used since a snapshot is the base of at most one
+// later snapshot.  Expanded snapshots can be read in any order from
+// any thread.
+class blob_reader
+{
+public:
+  explicit blob_reader(const std::string& fname);
+
+  blob_reader(const blob_reader&) = delete;
+  blob_reader& operator=(const blob_reader&) = delete;
+  blob_reader(blob_reader&&) = delete;
+  blob_reader& operator=(blob_reader&&) = delete;
+
+  // Check if snapshot is full or its base has been expanded
+  bool
+  has_base(const blob_writer::snapshot& snap);
+
+  // Convert snapshot to a full chunk list.  Returns 0 on success.
+  int
+  expand(blob_writer::snapshot& snap);
+
+  // Read expanded snapshot into buf of at least total_size bytes.
+  // Returns 0 on success.
+  int
+  read(const blob_writer::snapshot& snap, void* buf, size_t size);
+
+private:
+  int
+  read_chunk_nolock(const blob_hash& hash, char* buf, uint32_t size);
+
+  std::mutex mlock;
+  std::ifstream ifile;
+  std::unordered_map<blob_hash, std::pair<uint64_t, uint32_t>, blob_hash_hasher> index{};
+  std::unordered_map<uint64_t, std::vector<blob_hash>> snapshots{};
+};
+
+} // namespace xrt::tools::xbtracer
+
+#endif // xbtracer_common_trace_blob_h
@@ -39,6 +39,9 @@ localtime_os(std::tm& tm, const std::time_t& t);
 uint32_t
 getpid_current_os();
 
+uint32_t
+gettid_current_os();
+
 lib_handle_type
 load_library_os(const char* path);
 
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <dlfcn.h>
 #include <cstdlib>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include <common/trace_utils.h>
 
@@ -54,6 +55,14 @@ getpid_current_os()
   return static_cast<uint32_t>(pid);
 }
 
+uint32_t
+gettid_current_os()
+{
+  auto tid = syscall(SYS_gettid);
+
+  return static_cast<uint32_t>(tid);
+}
+
 lib_handle_type
 load_library_os(const char* path)
 {
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
 
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <string>
 #include <thread>
@@ -22,14 +26,36 @@ using namespace xrt::tools::xbtracer;
 
 struct cmd_arg {
   std::string in_file;
+  std::string blob_file;
+  std::string latency_file;
+  bool parallel = false;
+  xbreplay_pacer::mode timing = xbreplay_pacer::mode::fast;
+  double scale = 1.0;
 };
 
+// Functions captured from one thread of one process
+struct xbreplay_stream {
+  std::shared_ptr<xbreplay_msg_queue> queue;
+  std::thread thread;
+  xbreplay_stats stats;
+};
+
+// Wait time for an object created by another stream in parallel replay
+constexpr std::chrono::milliseconds xbreplay_parallel_track_wait{1000};
+
 static void usage(const char* cmd) {
   std::cout << "Usage: " << cmd << " [options] -i <xbtracer_capture_file> -o <output_file>" << std::endl;
   std::cout << "This program is to convert xbtracer captured files to specified format output." << std::endl;
   std::cout << "Required:" << std::endl;
   std::cout << "\t-i|--input <xbtracer_capture_file> file contains what's captured by xbtracer" << std::endl;
   std::cout << "Optinoal:" << std::endl;
+  std::cout << "\t-b|--blob <blob_file> file contains buffer data referenced by the capture file," << std::endl;
+  std::cout << "\t                      default is the capture file with .blob extension" << std::endl;
+  std::cout << "\t-p|--parallel replay functions of each captured process/thread concurrently" << std::endl;
+  std::cout << "\t-t|--timing <fast|original|scaled> pace of replay, default is fast," << std::endl;
+  std::cout << "\t                      original keeps the captured interval between functions" << std::endl;
+  std::cout << "\t-s|--scale <factor> speed up factor of captured intervals for scaled timing" << std::endl;
+  std::cout << "\t-l|--latency <file> write per API latency of replayed functions as CSV" << std::endl;
   std::cout << "\t-h|--help display this helper messsage." << std::endl;
 }
 
@@ -48,6 +74,43 @@ parse_args(struct cmd_arg &args, int argc, const char* argv[])
     else if (arg_str == "-i" || arg_str == "--input") {
       args.in_file = argv[++i];
     }
+    else if (arg_str == "-b" || arg_str == "--blob") {
+      args.blob_file = argv[++i];
+    }
+    else if (arg_str == "-p" || arg_str == "--parallel") {
+      args.parallel = true;
+    }
+    else if (arg_str == "-t" || arg_str == "--timing") {
+      std::string timing = argv[++i];
+      if (timing == "fast")
+        args.timing = xbreplay_pacer::mode::fast;
+      else if (timing == "original")
+        args.timing = xbreplay_pacer::mode::original;
+      else if (timing == "scaled")
+        args.timing = xbreplay_pacer::mode::scaled;
+      else {
+        xbtracer_perror("unsupported timing \"", timing, "\".");
+        return -EINVAL;
+      }
+    }
+    else if (arg_str == "-s" || arg_str == "--scale") {
+      std::string scale = (i + 1 < argc) ? argv[++i] : "";
+      size_t pos = 0;
+      try {
+        args.scale = std::stod(scale, &pos);
+      }
+      catch (const std::exception&) {
+        pos = 0;
+      }
+      if (!pos || pos != scale.size() || !std::isfinite(args.scale) || args.scale <= 0) {
+        xbtracer_perror("timing scale must be a positive number, got \"", scale, "\".");
+        usage(argv[0]);
+        return -EINVAL;
+      }
+    }
+    else if (arg_str == "-l" || arg_str == "--latency") {
+      args.latency_file = argv[++i];
+    }
   }
 
   if (args.in_file.empty()) {
@@ -62,14 +125,15 @@ parse_args(struct cmd_arg &args, int argc, const char* argv[])
 static
 void
 xbreplay_worker(std::shared_ptr<replayer> replayer_sh,
-                std::shared_ptr<xbreplay_msg_queue> queue_sh)
+                std::shared_ptr<xbreplay_msg_queue> queue_sh,
+                const xbreplay_pacer* pacer, xbreplay_stats* stats)
 {
-  xbreplay_receive_msgs(replayer_sh, queue_sh);
+  xbreplay_receive_msgs(replayer_sh, queue_sh, *pacer, *stats);
 }
 
 static
 bool
-xbreplay_coded_get_sequence_from_file(std::ifstream& input)
+xbreplay_coded_get_sequence_from_file(std::ifstream& input, const struct cmd_arg& args)
 {
   google::protobuf::io::IstreamInputStream raw_input(&input);
   google::protobuf::io::CodedInputStream coded_input(&raw_input);
@@ -87,31 +151,107 @@ xbreplay_coded_get_sequence_from_file(std::ifstream& input)
   coded_input.PopLimit(limit);
   xbtracer_pinfo("APIs sequence captured for XRT version: ", header_msg.version(), ".");
 
-  // We only have one queue at the moment
-  std::shared_ptr<xbreplay_msg_queue> queue_sh = std::make_shared<xbreplay_msg_queue>();
+  // In serial replay all functions go through one stream.  In parallel
+  // replay there is one stream per captured (pid, tid), created when
+  // the first function of the thread is read.
   std::shared_ptr<replayer> replayer_sh = std::make_shared<replayer>();
-  std::thread replayer_t(xbreplay_worker, replayer_sh, queue_sh);
+  if (args.parallel)
+    replayer_sh->set_track_wait(xbreplay_parallel_track_wait);
+  xbreplay_pacer pacer(args.timing, args.scale);
+  std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<xbreplay_stream>> streams;
+  auto get_stream = [&](const xbtracer_proto::Func& msg) -> xbreplay_stream& {
+    auto key = args.parallel ? std::make_pair(msg.pid(), msg.tid()) : std::make_pair(0U, 0U);
+    auto& stream = streams[key];
+    if (!stream) {
+      stream = std::make_unique<xbreplay_stream>();
+      stream->queue = std::make_shared<xbreplay_msg_queue>();
+      stream->thread = std::thread(xbreplay_worker, replayer_sh, stream->queue, &pacer, &stream->stats);
+    }
+    return *stream;
+  };
+  auto end_streams = [&]() {
+    for (auto& [key, stream] : streams)
+      stream->queue->end_queue();
+    for (auto& [key, stream] : streams)
+      stream->thread.join();
+  };
 
   // The version of protobuf we have doesn't have IsAtEnd() or PeekTag() method which can be
   // used to check if it is the end of stream. And thus, we read the 32bit for size. If we
   // fail to read the 32bit size, it means it reaches the end of stream.
   xbtracer_pinfo("reading XRT APIs...");
+  bool first = true;
+  bool ok = true;
+  auto dispatch = [&](const std::shared_ptr<xbtracer_proto::Func>& msg) {
+    if (first) {
+      pacer.start(*msg);
+      first = false;
+    }
+    get_stream(*msg).queue->push(msg);
+  };
+
+  // A buffer synced from two threads can have its delta traced before
+  // its base.  Messages are held from the first such delta until its
+  // base is expanded, then dispatched in trace order.
+  std::deque<std::pair<std::shared_ptr<xbtracer_proto::Func>, bool>> pending;
+  auto resolve_pending = [&]() {
+    for (bool progress = true; progress;) {
+      progress = false;
+      for (auto& [msg, expanded] : pending) {
+        if (expanded)
+          continue;
+        auto ret = expand_blob_args(*msg);
+        if (ret < 0) {
+          xbtracer_perror("failed to resolve buffer data of ", msg->name(), ".");
+          return false;
+        }
+        expanded = progress = (ret == 0);
+      }
+    }
+    for (; !pending.empty() && pending.front().second; pending.pop_front())
+      dispatch(pending.front().first);
+    return true;
+  };
+
   while (coded_input.ReadVarint32(&size)) {
     limit = coded_input.PushLimit(static_cast<int>(size));
     std::shared_ptr<xbtracer_proto::Func> sh_func_msg = std::make_shared<xbtracer_proto::Func>();
     if (!sh_func_msg->ParseFromCodedStream(&coded_input)) {
       xbtracer_perror("failed to parse header from coded protobuf input.");
-      return false;
+      ok = false;
+      break;
     }
     coded_input.PopLimit(limit);
-    queue_sh->push(sh_func_msg);
+    pending.emplace_back(sh_func_msg, false);
+    if (!resolve_pending()) {
+      ok = false;
+      break;
+    }
+  }
+  if (ok && !pending.empty()) {
+    xbtracer_perror("failed to resolve buffer data of ", pending.front().first->name(),
+                    ", base snapshot not found in trace.");
+    ok = false;
   }
   xbtracer_pinfo("Done reading XRT APIs...");
-  queue_sh->end_queue();
+  end_streams();
+  replayer_sh->untrack_all();
+
+  xbreplay_stats stats;
+  for (auto& [key, stream] : streams)
+    stats.merge(stream->stats);
+  xbtracer_pinfo("Replayed ", streams.size(), " stream(s), latency per API:");
+  stats.report(std::cout, false);
+  if (!args.latency_file.empty()) {
+    std::ofstream ofile(args.latency_file);
+    if (ofile.is_open())
+      stats.report(ofile, true);
+    else
+      xbtracer_perror("failed to open latency file \"", args.latency_file, "\".");
+  }
 
-  replayer_t.join();
   google::protobuf::ShutdownProtobufLibrary();
-  return true;
+  return ok;
 }
 
 int
@@ -141,8 +281,24 @@ main(int argc, const char* argv[])
     return -EINVAL;
   }
 
+  // Buffer data may be stored in a separate blob file, it is optional
+  // for captures which have all data inline.
+  std::string blob_file = args.blob_file;
+  if (blob_file.empty())
+    blob_file = blob_file_name_from_trace(args.in_file);
+  if (std::filesystem::exists(blob_file)) {
+    if (open_blob_file(blob_file)) {
+      xbtracer_perror("failed to open blob file \"", blob_file, "\".");
+      return -EINVAL;
+    }
+  }
+  else if (!args.blob_file.empty()) {
+    xbtracer_perror("blob file \"", blob_file, "\" does not exist.");
+    return -EINVAL;
+  }
+
   xbtracer_pinfo("Replaying \"", args.in_file, "\".");
-  if (!xbreplay_coded_get_sequence_from_file(in_file)) {
+  if (!xbreplay_coded_get_sequence_from_file(in_file, args)) {
     xbtracer_perror("Failed to replay \"", args.in_file, "\".");
     return -EINVAL;
   }
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+#include <replay/xbreplay_common.h>
+
+namespace xrt::tools::xbtracer
+{
+static std::unique_ptr<blob_reader> blob_store;
+
+static blob_writer::snapshot
+blob_snapshot_from_proto(const xbtracer_proto::BlobRef& blob)
+{
+  blob_writer::snapshot snap;
+  snap.id = blob.snapshot_id();
+  snap.base_id = blob.base_id();
+  snap.chunk_size = blob.chunk_size();
+  snap.total_size = blob.total_size();
+  snap.chunks.reserve(blob.chunks_size());
+  for (const auto& c : blob.chunks())
+    snap.chunks.push_back({c.index(), {c.hash_lo(), c.hash_hi()}});
+  return snap;
+}
+
+int
+read_blob_arg(const xbtracer_proto::Func& func_msg, const xbtracer_proto::Arg& arg, void* buf,
+              size_t size)
+{
+  if (!blob_store) {
+    xbtracer_perror(func_msg.name(), ", arg ", arg.name(), " is stored in blob file, but no blob file.");
+    return -1;
+  }
+  return blob_store->read(blob_snapshot_from_proto(arg.blob()), buf, size);
+}
+
+int
+open_blob_file(const std::string& fname)
+{
+  try {
+    blob_store = std::make_unique<blob_reader>(fname);
+  }
+  catch (const std::exception& e) {
+    xbtracer_perror(e.what());
+    return -1;
+  }
+  return 0;
+}
+
+static bool
+is_expandable(const xbtracer_proto::Arg& arg)
+{
+  // Full snapshots are expanded too, they are the base of a later
+  // delta of the same buffer
+  return arg.has_blob() && (arg.blob().snapshot_id() || arg.blob().base_id());
+}
+
+int
+expand_blob_args(xbtracer_proto::Func& func_msg)
+{
+  // Check all bases first so a message is expanded entirely or not at all
+  for (const auto& arg : func_msg.arg()) {
+    if (!is_expandable(arg))
+      continue;
+    if (!blob_store) {
+      xbtracer_perror(func_msg.name(), ", arg ", arg.name(), " is stored in blob file, but no blob file.");
+      return -1;
+    }
+    if (!blob_store->has_base(blob_snapshot_from_proto(arg.blob())))
+      return 1;
+  }
+
+  for (auto& arg : *func_msg.mutable_arg()) {
+    if (!is_expandable(arg))
+      continue;
+    auto snap = blob_snapshot_from_proto(arg.blob());
+    if (blob_store->expand(snap))
+      return -1;
+    auto blob = arg.mutable_blob();
+    blob->set_base_id(0);
+    blob->clear_chunks();
+    for (const auto& c : snap.chunks) {
+      auto chunk = blob->add_chunks();
+      chunk->set_index(c.index);
+      chunk->set_hash_lo(c.hash.lo);
+      chunk->set_hash_hi(c.hash.hi);
+    }
+  }
+  return 0;
+}
+
+} //namespace xrt::tools::xbtracer
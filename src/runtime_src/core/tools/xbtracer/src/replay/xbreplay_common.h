@@ -4,12 +4,16 @@
 #ifndef xbreplay_common_h
 #define xbreplay_common_h
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <ostream>
 #include <queue>
+#include <string>
 #include <tuple>
 #include <typeinfo>
+#include <vector>
 #include <condition_variable>
 
 #include <xrt.h>
@@ -35,6 +39,7 @@
 
 #include "func.pb.h"
 
+#include <common/trace_blob.h>
 #include <common/trace_utils.h>
 
 namespace xrt::tools::xbtracer
@@ -66,6 +71,57 @@ private:
   uint32_t ended;
 };
 
+// class xbreplay_pacer - pace replayed functions
+//
+// In fast mode functions are replayed as fast as possible.  Otherwise
+// a function is replayed no earlier than its captured offset from the
+// first captured function, divided by the scale (speed up) factor.
+class xbreplay_pacer
+{
+public:
+  enum class mode
+  {
+    fast,
+    original,
+    scaled,
+  };
+
+  xbreplay_pacer(mode m, double scale);
+
+  // Set time base, called with the first captured function before
+  // any function is replayed.
+  void
+  start(const xbtracer_proto::Func& first_msg);
+
+  // Block until msg is due to be replayed
+  void
+  wait(const xbtracer_proto::Func& msg) const;
+
+private:
+  mode pmode;
+  double pscale;
+  int64_t trace_start_ns = 0;
+  std::chrono::steady_clock::time_point replay_start{};
+};
+
+// class xbreplay_stats - latency of replayed functions per API
+class xbreplay_stats
+{
+public:
+  void
+  add(const std::string& name, std::chrono::nanoseconds latency);
+
+  void
+  merge(const xbreplay_stats& other);
+
+  // Print count, min, mean, percentiles and max per API in us
+  void
+  report(std::ostream& os, bool csv) const;
+
+private:
+  std::map<std::string, std::vector<int64_t>> latencies{};
+};
+
 
 class replayer
 {
@@ -156,6 +212,12 @@ public:
   void
   untrack_xclbin(uint64_t impl);
 
+  // When functions are replayed concurrently, an object can be used
+  // by one stream before the stream creating it got to it.  Lookup of
+  // a tracked object waits up to timeout for the object to appear.
+  void
+  set_track_wait(std::chrono::milliseconds timeout);
+
 private:
   void
   register_bo_func();
@@ -195,6 +257,7 @@ private:
       return 0;
     }
     tracker[impl] = obj;
+    trackers_cond.notify_all();
     return 0;
   }
 
@@ -202,8 +265,14 @@ private:
   std::shared_ptr<T>
   get_tracked_obj(uint64_t impl, std::map<uint64_t, std::shared_ptr<T>>& tracker)
   {
-    std::lock_guard<std::mutex> lock(trackers_mlock);
+    std::unique_lock<std::mutex> lock(trackers_mlock);
     auto it = tracker.find(impl);
+    if (it == tracker.end() && track_wait.count()) {
+      trackers_cond.wait_for(lock, track_wait, [&] {
+        it = tracker.find(impl);
+        return it != tracker.end();
+      });
+    }
     if (it != tracker.end()) {
       return it->second;
     }
@@ -222,6 +291,8 @@ private:
   }
 
   std::mutex trackers_mlock;
+  std::condition_variable trackers_cond;
+  std::chrono::milliseconds track_wait{0};
   std::map<std::string,
            std::function<int(const xbtracer_proto::Func*,
                          const xbtracer_proto::Func*)>> xbreplay_funcs_map{};
@@ -258,12 +329,34 @@ int
 copy_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id, void* buf,
                         size_t size);
 
+// Returned pointer of an argument stored in the blob file is only
+// valid until the next call from the same thread.
 const void*
 get_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id, size_t& size);
 
+// Open blob file holding buffer payloads referenced by the trace
+int
+open_blob_file(const std::string& fname);
+
+// Read payload of an argument stored in the blob file, a delta
+// encoded argument must have been expanded by expand_blob_args()
+int
+read_blob_arg(const xbtracer_proto::Func& func_msg, const xbtracer_proto::Arg& arg, void* buf,
+              size_t size);
+
+// Expand delta encoded blob references of a message and record full
+// snapshots as the base of later deltas, must be called on messages
+// before they are replayed.  Returns 0 on success, 1 if the base of a
+// delta is not yet expanded, the message is left unchanged and must
+// be expanded again once the message holding the base is expanded,
+// and negative on error.
+int
+expand_blob_args(xbtracer_proto::Func& func_msg);
+
 void
 xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
-                      std::shared_ptr<xbreplay_msg_queue>& queue);
+                      std::shared_ptr<xbreplay_msg_queue>& queue,
+                      const xbreplay_pacer& pacer, xbreplay_stats& stats);
 
 } // namespace xrt::tools::xbtracer
 
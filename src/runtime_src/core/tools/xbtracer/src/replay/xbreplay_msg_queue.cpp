@@ -58,8 +58,11 @@ void
 xbreplay_msg_queue::
 end_queue()
 {
-  std::lock_guard<std::mutex> lock(mlock);
-  ended = 1;
+  {
+    std::lock_guard<std::mutex> lock(mlock);
+    ended = 1;
+  }
+  cond.notify_all();
 }
 
 } // namespace xrt::tools::xbtracer
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <replay/xbreplay_common.h>
+
+namespace xrt::tools::xbtracer
+{
+
+static int64_t
+get_msg_time_ns(const xbtracer_proto::Func& msg)
+{
+  constexpr int64_t s_to_ns = 1000000000;
+  return msg.timestamp().seconds() * s_to_ns + msg.timestamp().nanos();
+}
+
+xbreplay_pacer::
+xbreplay_pacer(mode m, double scale)
+  : pmode(m)
+  , pscale(m == mode::original ? 1.0 : scale)
+{
+  if (pmode == mode::scaled && pscale <= 0)
+    throw std::invalid_argument("xbreplay: timing scale must be positive.");
+}
+
+void
+xbreplay_pacer::
+start(const xbtracer_proto::Func& first_msg)
+{
+  trace_start_ns = get_msg_time_ns(first_msg);
+  replay_start = std::chrono::steady_clock::now();
+}
+
+void
+xbreplay_pacer::
+wait(const xbtracer_proto::Func& msg) const
+{
+  if (pmode == mode::fast)
+    return;
+
+  auto offset_ns = get_msg_time_ns(msg) - trace_start_ns;
+  if (offset_ns <= 0)
+    return;
+
+  auto delay = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(offset_ns) / pscale));
+  std::this_thread::sleep_until(replay_start + delay);
+}
+
+} // namespace xrt::tools::xbtracer
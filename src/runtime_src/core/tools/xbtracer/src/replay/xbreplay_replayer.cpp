@@ -139,6 +139,14 @@ track_device_handle(uint64_t traced_h, uint64_t impl)
   return 0;
 }
 
+void
+replayer::
+set_track_wait(std::chrono::milliseconds timeout)
+{
+  std::lock_guard<std::mutex> lock(trackers_mlock);
+  track_wait = timeout;
+}
+
 void
 replayer::
 untrack_all()
@@ -313,6 +321,14 @@ copy_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id,
                         size_t size)
 {
   const xbtracer_proto::Arg& arg = func_msg.arg(arg_id);
+  if (arg.has_blob()) {
+    if (arg.blob().total_size() != size) {
+      xbtracer_perror(func_msg.name(), ", arg[", arg_id, "] buf size mismatched: ", size, ",",
+                      arg.blob().total_size());
+      return -1;
+    }
+    return read_blob_arg(func_msg, arg, buf, size);
+  }
   const std::string& data_str = arg.value();
   size_t data_size = data_str.size();
   if (data_size != size) {
@@ -328,6 +344,16 @@ const void*
 get_data_from_proto_arg(const xbtracer_proto::Func& func_msg, uint32_t arg_id, size_t& size)
 {
   const xbtracer_proto::Arg& arg = func_msg.arg(arg_id);
+  if (arg.has_blob()) {
+    thread_local std::vector<char> blob_data;
+    blob_data.resize(arg.blob().total_size());
+    if (read_blob_arg(func_msg, arg, blob_data.data(), blob_data.size())) {
+      size = 0;
+      return nullptr;
+    }
+    size = blob_data.size();
+    return blob_data.data();
+  }
   size = arg.value().size();
   return arg.value().data();
 }
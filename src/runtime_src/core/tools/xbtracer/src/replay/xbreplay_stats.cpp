@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <replay/xbreplay_common.h>
+
+namespace xrt::tools::xbtracer
+{
+
+void
+xbreplay_stats::
+add(const std::string& name, std::chrono::nanoseconds latency)
+{
+  latencies[name].push_back(latency.count());
+}
+
+void
+xbreplay_stats::
+merge(const xbreplay_stats& other)
+{
+  for (const auto& [name, samples] : other.latencies) {
+    auto& dst = latencies[name];
+    dst.insert(dst.end(), samples.begin(), samples.end());
+  }
+}
+
+void
+xbreplay_stats::
+report(std::ostream& os, bool csv) const
+{
+  constexpr double ns_to_us = 1000.0;
+  auto percentile = [](const std::vector<int64_t>& sorted, double p) {
+    auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[idx]) / ns_to_us;
+  };
+
+  if (csv)
+    os << "api,count,min_us,mean_us,p50_us,p90_us,p99_us,max_us\n";
+  else
+    os << std::left << std::setw(64) << "API" << std::right
+       << std::setw(10) << "count" << std::setw(12) << "min(us)" << std::setw(12) << "mean(us)"
+       << std::setw(12) << "p50(us)" << std::setw(12) << "p90(us)" << std::setw(12) << "p99(us)"
+       << std::setw(12) << "max(us)" << "\n";
+
+  os << std::fixed << std::setprecision(2);
+  for (const auto& [name, samples] : latencies) {
+    if (samples.empty())
+      continue;
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto mean = static_cast<double>(std::accumulate(sorted.begin(), sorted.end(), int64_t(0)))
+      / static_cast<double>(sorted.size()) / ns_to_us;
+    if (csv)
+      os << "\"" << name << "\"," << sorted.size() << "," << percentile(sorted, 0) << "," << mean
+         << "," << percentile(sorted, 0.5) << "," << percentile(sorted, 0.9) << ","
+         << percentile(sorted, 0.99) << "," << percentile(sorted, 1) << "\n";
+    else
+      os << std::left << std::setw(64) << name << std::right
+         << std::setw(10) << sorted.size() << std::setw(12) << percentile(sorted, 0)
+         << std::setw(12) << mean << std::setw(12) << percentile(sorted, 0.5)
+         << std::setw(12) << percentile(sorted, 0.9) << std::setw(12) << percentile(sorted, 0.99)
+         << std::setw(12) << percentile(sorted, 1) << "\n";
+  }
+}
+
+} // namespace xrt::tools::xbtracer
@@ -33,9 +33,21 @@ xbreplay_func_proto_to_json(const xbtracer_proto::Func& func_msg, std::string& j
 #endif
 }
 
+static
+int
+xbreplay_timed_replay(std::shared_ptr<replayer>& replayer_sh, const xbtracer_proto::Func* entry_msg,
+                      const xbtracer_proto::Func* exit_msg, xbreplay_stats& stats)
+{
+  auto start = std::chrono::steady_clock::now();
+  int ret = replayer_sh->replay(entry_msg, exit_msg);
+  stats.add(entry_msg->name(), std::chrono::steady_clock::now() - start);
+  return ret;
+}
+
 void
 xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
-                      std::shared_ptr<xbreplay_msg_queue>& queue)
+                      std::shared_ptr<xbreplay_msg_queue>& queue,
+                      const xbreplay_pacer& pacer, xbreplay_stats& stats)
 {
   xbtracer_pinfo("Replay worker waiting for messages...");
   std::shared_ptr<xbtracer_proto::Func> func_entry;
@@ -45,8 +57,8 @@ xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
     std::shared_ptr<xbtracer_proto::Func> sh_func_msg;
     queue->wait_and_pop(sh_func_msg);
     if (!sh_func_msg) {
+      // tracked objects are released by main thread once all streams are done
       xbtracer_pinfo("No more XRT function messages provided by main thread.");
-      replayer_sh->untrack_all();
       return;
     }
     if (!wait_exit_n_entry) {
@@ -58,8 +70,9 @@ xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
                            sh_func_msg->name(), ":\n",  json_str);
       }
       func_entry = sh_func_msg;
+      pacer.wait(*func_entry);
       if (sh_func_msg->status() == xbtracer_proto::Func_FuncStatus_FUNC_INJECT) {
-        if (replayer_sh->replay(func_entry.get(), nullptr)) {
+        if (xbreplay_timed_replay(replayer_sh, func_entry.get(), nullptr, stats)) {
           json_str.clear();
           (void)xbreplay_func_proto_to_json(*sh_func_msg, json_str);
           xbtracer_pcritical("Failed to replay ", func_entry->name(), ".\n", json_str);
@@ -69,7 +82,7 @@ xbreplay_receive_msgs(std::shared_ptr<replayer>& replayer_sh,
       wait_exit_n_entry = true;
     } else {
       wait_exit_n_entry = false;
-      if (replayer_sh->replay(func_entry.get(), sh_func_msg.get())) {
+      if (xbreplay_timed_replay(replayer_sh, func_entry.get(), sh_func_msg.get(), stats)) {
         json_str.clear();
         (void)xbreplay_func_proto_to_json(*sh_func_msg, json_str);
         xbtracer_pcritical("Failed to replay ", func_entry->name(), ".\n", json_str);
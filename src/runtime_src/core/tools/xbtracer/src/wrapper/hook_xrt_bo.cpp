@@ -152,7 +152,8 @@ sync(xclBOSyncDirection dir, size_t sz, size_t offset)
         xbtracer_pcritical(std::string(func_s), ", failed to get mapped buffer.");
       }
       ptr += offset;
-      xbtracer_trace_mem_dump(ptr, sz, 1, "data", func_entry);
+      xbtracer_trace_mem_dump(ptr, sz, reinterpret_cast<uint64_t>(get_handle().get()), offset,
+                              1, "data", func_entry);
     }
   }
   xbtracer_write_protobuf_msg(func_entry, need_trace);
@@ -177,7 +178,8 @@ sync(xclBOSyncDirection dir, size_t sz, size_t offset)
   if (need_trace) {
     // TODO: we always include content from the buffer for now
     if (dir == XCL_BO_SYNC_BO_FROM_DEVICE || dir == XCL_BO_SYNC_BO_AIE_TO_GMIO) {
-      xbtracer_trace_mem_dump(ptr, sz, 1, "data", func_exit);
+      xbtracer_trace_mem_dump(ptr, sz, reinterpret_cast<uint64_t>(get_handle().get()), offset,
+                              1, "data", func_exit);
     }
   }
   xbtracer_write_protobuf_msg(func_exit, need_trace);
@@ -23,12 +23,15 @@
 
 namespace xrt::tools::xbtracer
 {
-  tracer::tracer(const std::string& outf, tracer::level tl) :
+  tracer::tracer(const std::string& outf, tracer::level tl, uint32_t blob_chunk_size) :
 	 tracer_ofile(outf, std::ios::out | std::ios::binary | std::ios::trunc),
          tlevel(tl)
   {
     if (!tracer_ofile || !tracer_ofile.is_open())
       throw std::runtime_error("xbtracer failed to open output file: \"" + std::string(outf) + "\".");
+    // chunk size 0 disables the blob file, payloads are stored inline
+    if (blob_chunk_size)
+      blob_store = std::make_unique<blob_writer>(blob_file_name_from_trace(outf), blob_chunk_size);
     coreutil_lib_h = load_library_os(XBRACER_XRT_COREUTIL_LIB);
     if (!coreutil_lib_h)
       throw std::runtime_error("xbrtracer failer to open lib: \"" +
@@ -62,6 +65,9 @@ namespace xrt::tools::xbtracer
 
   tracer::~tracer()
   {
+    if (blob_store)
+      xbtracer_pinfo("blob file referenced ", blob_store->get_referenced_bytes(), " bytes, stored ",
+                     blob_store->get_stored_bytes(), " bytes.");
     if (coreutil_lib_h)
       close_library_os(coreutil_lib_h);
     if (tracer_ofile.is_open())
@@ -74,6 +80,28 @@ namespace xrt::tools::xbtracer
     return get_proc_addr_os(coreutil_lib_h, symbol);
   }
 
+  bool
+  tracer::write_blob(const void* data, size_t size, const blob_writer::buffer_key* key,
+                     xbtracer_proto::Arg* arg)
+  {
+    if (!blob_store || size < blob_min_payload_size)
+      return false;
+
+    auto snap = key ? blob_store->add(data, size, *key) : blob_store->add(data, size);
+    auto blob = arg->mutable_blob();
+    blob->set_snapshot_id(snap.id);
+    blob->set_base_id(snap.base_id);
+    blob->set_chunk_size(snap.chunk_size);
+    blob->set_total_size(snap.total_size);
+    for (const auto& c : snap.chunks) {
+      auto chunk = blob->add_chunks();
+      chunk->set_index(c.index);
+      chunk->set_hash_lo(c.hash.lo);
+      chunk->set_hash_hi(c.hash.hi);
+    }
+    return true;
+  }
+
   bool
   tracer::trace_pid(uint32_t pid)
   {
@@ -108,6 +136,7 @@ namespace xrt::tools::xbtracer
 
   constexpr size_t tracer_tlevel_str_len_max = 16;
   constexpr size_t tracer_dir_str_len_max = 2048;
+  constexpr size_t tracer_chunk_str_len_max = 32;
 
   tracer&
   tracer::get_instance()
@@ -117,10 +146,25 @@ namespace xrt::tools::xbtracer
       // Get environment variable to get the path and the tracing level
       std::string tlevel(tracer_tlevel_str_len_max, '\0');
       std::string odir(tracer_dir_str_len_max, '\0');
+      std::string chunk(tracer_chunk_str_len_max, '\0');
       getenv_os("XBTRACER_OUT_DIR", odir.data(), odir.capacity());
       getenv_os("XBRACER_TRACE_LEVEL", tlevel.data(), tlevel.capacity());
+      getenv_os("XBTRACER_BLOB_CHUNK_SIZE", chunk.data(), chunk.capacity());
       tracer::level l = tracer::level::DEFAULT;
 
+      // Malformed or out of range chunk size falls back to default
+      uint32_t chunk_size = blob_default_chunk_size;
+      if (strlen(chunk.c_str())) {
+        char* end = nullptr;
+        errno = 0;
+        auto value = std::strtoul(chunk.c_str(), &end, 10);
+        if (errno || end == chunk.c_str() || *end || !value || value > UINT32_MAX)
+          xbtracer_pwarning("invalid XBTRACER_BLOB_CHUNK_SIZE \"", chunk.c_str(), "\", using default ",
+                            blob_default_chunk_size, ".");
+        else
+          chunk_size = static_cast<uint32_t>(value);
+      }
+
       if (strlen(tlevel.c_str())) {
 	// TODO: we only support DEFAULT tracing level for now.
         tlevel.resize(strlen(tlevel.c_str()));
@@ -139,7 +183,7 @@ namespace xrt::tools::xbtracer
       opath.append(std::string("trace_protobuf" + std::to_string(pid) + ".bin"));
       // convert path to string first before converting it to c string to
       // make it work for both Linux and Windows.
-      instance = std::unique_ptr<tracer>(new tracer(opath.string(), l));
+      instance = std::unique_ptr<tracer>(new tracer(opath.string(), l, chunk_size));
 
       // Log XRT version
       GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -453,15 +497,32 @@ xbtracer_trace_file_content(const std::string& fname, uint32_t arg_id,
   return true;
 }
 
-bool
-xbtracer_trace_mem_dump(const void* data, size_t size, uint32_t arg_id,
-                        const std::string& arg_name, xbtracer_proto::Func& func_msg)
+static bool
+trace_mem_dump(const void* data, size_t size, const xrt::tools::xbtracer::blob_writer::buffer_key* key,
+               uint32_t arg_id, const std::string& arg_name, xbtracer_proto::Func& func_msg)
 {
   xbtracer_proto::Arg* arg = func_msg.add_arg();
   arg->set_name(arg_name);
   arg->set_index(arg_id);
   arg->set_type("byes");
   arg->set_size(static_cast<uint32_t>(size));
-  arg->set_value(std::string(reinterpret_cast<const char*>(data), size));
+  if (!xrt::tools::xbtracer::tracer::get_instance().write_blob(data, size, key, arg))
+    arg->set_value(std::string(reinterpret_cast<const char*>(data), size));
   return true;
 }
+
+bool
+xbtracer_trace_mem_dump(const void* data, size_t size, uint32_t arg_id,
+                        const std::string& arg_name, xbtracer_proto::Func& func_msg)
+{
+  return trace_mem_dump(data, size, nullptr, arg_id, arg_name, func_msg);
+}
+
+bool
+xbtracer_trace_mem_dump(const void* data, size_t size, uint64_t buf_id, uint64_t offset,
+                        uint32_t arg_id, const std::string& arg_name,
+                        xbtracer_proto::Func& func_msg)
+{
+  xrt::tools::xbtracer::blob_writer::buffer_key key{buf_id, offset};
+  return trace_mem_dump(data, size, &key, arg_id, arg_name, func_msg);
+}
@@ -35,6 +35,7 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/timestamp.pb.h>
 #include <func.pb.h>
+#include <common/trace_blob.h>
 #include <common/trace_utils.h>
 
 template <typename PFUNC>
@@ -119,6 +120,7 @@ xbrtracer_init_func_proto_msg(PFUNC& func_msg, const char* func_name, PFUNC_TRAC
 
   uint32_t pid = getpid_current_os();
   func_msg.set_pid(pid);
+  func_msg.set_tid(gettid_current_os());
   func_msg.set_status(func_trace_type);
 }
 
@@ -132,7 +134,7 @@ class tracer
   };
 
 public:
-  tracer(const std::string& outf, level tl);
+  tracer(const std::string& outf, level tl, uint32_t blob_chunk_size);
 
   // we always need to output tracing to a file
   tracer() = delete;
@@ -165,6 +167,12 @@ public:
     return !coded_output.HadError();
   }
 
+  // Store buffer payload in the blob file and reference it from arg.
+  // Returns false if payload should be stored inline instead.
+  bool
+  write_blob(const void* data, size_t size, const blob_writer::buffer_key* key,
+             xbtracer_proto::Arg* arg);
+
   bool
   trace_pid(uint32_t pid);
 
@@ -301,6 +309,7 @@ private:
   static std::unique_ptr<tracer> instance;
   static std::once_flag init_instance_flag;
   std::fstream tracer_ofile;
+  std::unique_ptr<blob_writer> blob_store;
   level tlevel;
   lib_handle_type coreutil_lib_h;
   std::vector<uint32_t> trace_pids{};
@@ -519,4 +528,11 @@ xbtracer_trace_file_content(const std::string& fname, uint32_t arg_id,
 bool
 xbtracer_trace_mem_dump(const void* data, size_t size, uint32_t arg_id,
                         const std::string& arg_name, xbtracer_proto::Func& func_msg);
+
+// Dump memory of a buffer identified by (buf_id, offset).  Successive
+// dumps of the same buffer are delta encoded in the blob file.
+bool
+xbtracer_trace_mem_dump(const void* data, size_t size, uint64_t buf_id, uint64_t offset,
+                        uint32_t arg_id, const std::string& arg_name,
+                        xbtracer_proto::Func& func_msg);
 #endif // tracer_h
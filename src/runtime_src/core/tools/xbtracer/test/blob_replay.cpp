@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Replay of buffer payloads stored in a blob file
+//
+// A buffer synced several times is recorded as a full snapshot
+// followed by deltas against the previous snapshot of the same
+// buffer.  The test writes such a blob file, builds the trace
+// messages referring to it, and replays them the way xrt-replay
+// does: expand_blob_args(), then read_blob_arg().  Messages traced
+// from different threads can have a delta before its base, the
+// delta is expanded again once its base has been expanded.
+
+#include <replay/xbreplay_common.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace xrt::tools::xbtracer;
+
+static xbtracer_proto::Func
+make_sync_msg(const blob_writer::snapshot& snap)
+{
+  xbtracer_proto::Func msg;
+  msg.set_name("xrt::bo::sync");
+  auto arg = msg.add_arg();
+  arg->set_name("data");
+  auto blob = arg->mutable_blob();
+  blob->set_snapshot_id(snap.id);
+  blob->set_base_id(snap.base_id);
+  blob->set_chunk_size(snap.chunk_size);
+  blob->set_total_size(snap.total_size);
+  for (const auto& c : snap.chunks) {
+    auto chunk = blob->add_chunks();
+    chunk->set_index(c.index);
+    chunk->set_hash_lo(c.hash.lo);
+    chunk->set_hash_hi(c.hash.hi);
+  }
+  return msg;
+}
+
+static void
+run(const std::string& fname)
+{
+  constexpr uint32_t chunk_size = 4096;
+  constexpr size_t size = 4 * chunk_size;
+  const blob_writer::buffer_key key {1, 0};
+
+  // Sync the same buffer three times, changing one chunk each time
+  std::vector<std::vector<char>> payloads;
+  std::vector<xbtracer_proto::Func> msgs;
+  {
+    blob_writer writer(fname, chunk_size);
+    std::vector<char> data(size, 'a');
+    for (int sync = 0; sync < 3; ++sync) {
+      data[sync * chunk_size] = static_cast<char>('b' + sync);
+      auto snap = writer.add(data.data(), data.size(), key);
+      if (sync && !snap.base_id)
+        throw std::runtime_error("sync " + std::to_string(sync) + " not recorded as delta");
+      payloads.push_back(data);
+      msgs.push_back(make_sync_msg(snap));
+    }
+  }
+
+  if (open_blob_file(fname))
+    throw std::runtime_error("failed to open blob file");
+
+  // Trace order with the first delta emitted before its base
+  std::swap(msgs[0], msgs[1]);
+  std::swap(payloads[0], payloads[1]);
+  if (expand_blob_args(msgs[0]) != 1)
+    throw std::runtime_error("delta before its base not deferred");
+  if (msgs[0].arg(0).blob().base_id() == 0)
+    throw std::runtime_error("deferred delta modified");
+
+  for (size_t idx : {1, 0, 2}) {
+    if (expand_blob_args(msgs[idx]))
+      throw std::runtime_error("failed to expand sync " + std::to_string(idx));
+  }
+
+  for (size_t idx = 0; idx < msgs.size(); ++idx) {
+    std::vector<char> buf(size);
+    if (read_blob_arg(msgs[idx], msgs[idx].arg(0), buf.data(), buf.size()))
+      throw std::runtime_error("failed to read sync " + std::to_string(idx));
+    if (buf != payloads[idx])
+      throw std::runtime_error("payload mismatch for sync " + std::to_string(idx));
+  }
+}
+
+int main()
+{
+  auto fname = (std::filesystem::temp_directory_path() / "xbtracer_blob_replay.blob").string();
+  try {
+    run(fname);
+    std::remove(fname.c_str());
+    std::cout << "PASSED\n";
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "FAILED: " << ex.what() << '\n';
+  }
+  std::remove(fname.c_str());
+  return 1;
+}
@@ -2,6 +2,7 @@
 // Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved
 #define XDP_PLUGIN_SOURCE
 #include "xdp/profile/plugin/aie_trace/aie_trace_offload_manager.h"
+#include "core/common/config_reader.h"
 
 namespace xdp {
   using severity_level = xrt_core::message::severity_level;
@@ -45,14 +46,22 @@ uint64_t AIETraceOffloadManager::checkAndCapToBankSize(uint8_t memIndex, uint64_
       db{database},
       aieTraceImpl{impl},
       offloadEnabledPLIO(true),
-      offloadEnabledGMIO(true)
+      offloadEnabledGMIO(true),
+      streamToFile(xrt_core::config::get_aie_trace_settings_stream_to_file())
   {}
 
+  std::unique_ptr<AIETraceLogger>
+  AIETraceOffloadManager::createLogger(AIETraceOffloadData& data, io_type offloadType) {
+    if (streamToFile)
+      return std::make_unique<AIETraceStreamLogger>(data.streamWriters);
+    return std::make_unique<AIETraceDataLogger>(deviceID, offloadType);
+  }
+
   void AIETraceOffloadManager::initPLIO(void* handle, PLDeviceIntf* deviceIntf, uint64_t bufSize, uint64_t numStreams, XAie_DevInst* devInst) {
     if (!offloadEnabledPLIO)
       return;
 
-    plio.logger = std::make_unique<AIETraceDataLogger>(deviceID, io_type::PLIO);
+    plio.logger = createLogger(plio, io_type::PLIO);
 #ifndef XDP_CLIENT_BUILD
     plio.offloader = std::make_unique<AIETraceOffload>(handle, deviceID, deviceIntf, plio.logger.get(), true, bufSize, numStreams, devInst);
 #else
@@ -80,7 +89,7 @@ uint64_t AIETraceOffloadManager::checkAndCapToBankSize(uint8_t memIndex, uint64_
     if (!offloadEnabledGMIO)
       return;
 
-    gmio.logger = std::make_unique<AIETraceDataLogger>(deviceID, io_type::GMIO);
+    gmio.logger = createLogger(gmio, io_type::GMIO);
     // Use the client-specific AIETraceOffload constructor
     gmio.offloader = std::make_unique<AIETraceOffload>(
         handle, deviceID, deviceIntf, gmio.logger.get(), false, // isPLIO = false
@@ -100,7 +109,7 @@ uint64_t AIETraceOffloadManager::checkAndCapToBankSize(uint8_t memIndex, uint64_
       return;
     }
 
-    gmio.logger = std::make_unique<AIETraceDataLogger>(deviceID, io_type::GMIO);
+    gmio.logger = createLogger(gmio, io_type::GMIO);
     gmio.offloader = std::make_unique<AIETraceOffload>(handle, deviceID, deviceIntf, gmio.logger.get(), false, bufSize, numStreams, devInst);
     gmio.valid = true;
     std::stringstream msg;
@@ -157,36 +166,30 @@ uint64_t AIETraceOffloadManager::checkAndCapToBankSize(uint8_t memIndex, uint64_
   }
 
   void AIETraceOffloadManager::createTraceWriters(uint64_t numStreamsPLIO, uint64_t numStreamsGMIO, std::vector<VPWriter*>& writers) {
-    if (offloadEnabledPLIO) {
-      // Add writer for every PLIO stream
-      for (uint64_t n = 0; n < numStreamsPLIO; ++n) {
-        std::string fileName = "aie_trace_plio_" + std::to_string(deviceID) + "_" +
-                              std::to_string(n) + ".txt";
-        VPWriter *writer = new AIETraceWriter(
-          fileName.c_str(),
-          deviceID,
-          n,  // stream id
-          "", // version
-          "", // creation time
-          "", // xrt version
-          "",  // tool version
-          io_type::PLIO // offload type
-        );
-        writers.push_back(writer);
-        db->addOpenedFile(writer->getcurrentFileName(), "AIE_EVENT_TRACE", deviceID);
+    if (offloadEnabledPLIO)
+      createTraceWriters(plio, io_type::PLIO, numStreamsPLIO, writers);
 
-        std::stringstream msg;
-        msg << "Creating AIE trace file " << fileName << " for device " << deviceID;
-        xrt_core::message::send(severity_level::info, "XRT", msg.str());
-      }
-    }
+    if (offloadEnabledGMIO)
+      createTraceWriters(gmio, io_type::GMIO, numStreamsGMIO, writers);
+  }
 
-    if (offloadEnabledGMIO) {
-      // Add writer for every GMIO stream
-      for (uint64_t n = 0; n < numStreamsGMIO; ++n) {
-        std::string fileName = "aie_trace_gmio_" + std::to_string(deviceID) + "_" +
-                              std::to_string(n) + ".txt";
-        VPWriter *writer = new AIETraceWriter(
+  void AIETraceOffloadManager::createTraceWriters(AIETraceOffloadData& data, io_type offloadType,
+                                                  uint64_t numStreams, std::vector<VPWriter*>& writers) {
+    std::string prefix = (offloadType == io_type::PLIO) ? "aie_trace_plio_" : "aie_trace_gmio_";
+    bool directIO = xrt_core::config::get_aie_trace_settings_direct_io();
+
+    // Add writer for every stream
+    for (uint64_t n = 0; n < numStreams; ++n) {
+      std::string fileName = prefix + std::to_string(deviceID) + "_" +
+                             std::to_string(n) + ".txt";
+      VPWriter *writer = nullptr;
+      if (streamToFile) {
+        auto streamWriter = new AIETraceStreamWriter(fileName.c_str(), deviceID, n, directIO);
+        data.streamWriters.push_back(streamWriter);
+        writer = streamWriter;
+      }
+      else {
+        writer = new AIETraceWriter(
           fileName.c_str(),
           deviceID,
           n,  // stream id
@@ -194,15 +197,15 @@ uint64_t AIETraceOffloadManager::checkAndCapToBankSize(uint8_t memIndex, uint64_
           "", // creation time
           "", // xrt version
           "",  // tool version
-          io_type::GMIO // offload type
+          offloadType // offload type
         );
-        writers.push_back(writer);
-        db->addOpenedFile(writer->getcurrentFileName(), "AIE_EVENT_TRACE", deviceID);
-
-        std::stringstream msg;
-        msg << "Creating AIE trace file " << fileName << " for device " << deviceID;
-        xrt_core::message::send(severity_level::info, "XRT", msg.str());
       }
+      writers.push_back(writer);
+      db->addOpenedFile(writer->getcurrentFileName(), "AIE_EVENT_TRACE", deviceID);
+
+      std::stringstream msg;
+      msg << "Creating AIE trace file " << fileName << " for device " << deviceID;
+      xrt_core::message::send(severity_level::info, "XRT", msg.str());
     }
   }
 
@@ -10,6 +10,7 @@
 #include <memory>
 #include "core/common/message.h"
 #include "xdp/profile/database/events/creator/aie_trace_data_logger.h"
+#include "xdp/profile/writer/aie_trace/aie_trace_stream_writer.h"
 #include "xdp/profile/writer/aie_trace/aie_trace_writer.h"
 #include "xdp/profile/plugin/aie_trace/aie_trace_impl.h"
 #include "xdp/profile/device/pl_device_intf.h"
@@ -36,6 +37,8 @@ namespace xdp {
     bool valid = false;
     std::unique_ptr<AIETraceLogger> logger;
     std::unique_ptr<AIETraceOffload> offloader;
+    // Writers of trace streamed to file, owned by the plugin
+    std::vector<AIETraceStreamWriter*> streamWriters;
   };
 
 class AIETraceOffloadManager {
@@ -43,6 +46,9 @@ class AIETraceOffloadManager {
     void startPLIOOffload(bool continuousTrace, uint64_t offloadIntervalUs);
     void startGMIOOffload(bool continuousTrace, uint64_t offloadIntervalUs);
     uint64_t checkAndCapToBankSize(uint8_t memIndex, uint64_t desired);
+    std::unique_ptr<AIETraceLogger> createLogger(AIETraceOffloadData& data, io_type offloadType);
+    void createTraceWriters(AIETraceOffloadData& data, io_type offloadType,
+                            uint64_t numStreams, std::vector<VPWriter*>& writers);
 
     uint64_t deviceID;
     VPDatabase* db;
@@ -51,6 +57,7 @@ class AIETraceOffloadManager {
     AIETraceOffloadData gmio;
     bool offloadEnabledPLIO = false;
     bool offloadEnabledGMIO = false;
+    bool streamToFile = false;
 
   public:
     AIETraceOffloadManager(uint64_t device_id, VPDatabase* database, AieTraceImpl* impl=nullptr);
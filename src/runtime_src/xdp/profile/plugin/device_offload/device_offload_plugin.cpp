@@ -27,6 +27,7 @@
 #include "xdp/profile/plugin/device_offload/device_offload_plugin.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
 #include "xdp/profile/plugin/vp_base/info.h"
+#include "xdp/profile/writer/device_trace/device_trace_binary_writer.h"
 #include "xdp/profile/writer/device_trace/device_trace_writer.h"
 #include "xdp/profile/device/pl_device_trace_logger.h"
 #include "xdp/profile/device/tracedefs.h"
@@ -131,17 +132,28 @@ namespace xdp {
     std::string xrtVersion   = xdp::getXRTVersion() ;
     std::string toolVersion  = xdp::getToolVersion() ;
 
-    std::string filename = 
-      "device_trace_" + std::to_string(deviceId) + ".csv" ;
-
-    VPWriter* writer = new DeviceTraceWriter(filename.c_str(),
-                                             deviceId,
-                                             version,
-                                             creationTime,
-                                             xrtVersion,
-                                             toolVersion);
+    bool binary = (xrt_core::config::get_device_trace_format() == "binary") ;
+    std::string filename =
+      "device_trace_" + std::to_string(deviceId) + (binary ? ".bin" : ".csv") ;
+
+    VPWriter* writer = nullptr ;
+    if (binary)
+      writer = new DeviceTraceBinaryWriter(filename.c_str(),
+                                           deviceId,
+                                           version,
+                                           creationTime,
+                                           xrtVersion,
+                                           toolVersion);
+    else
+      writer = new DeviceTraceWriter(filename.c_str(),
+                                     deviceId,
+                                     version,
+                                     creationTime,
+                                     xrtVersion,
+                                     toolVersion);
     writers.push_back(writer);
-    db->addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+    db->addOpenedFile(writer->getcurrentFileName(),
+                      binary ? "VP_TRACE_BINARY" : "VP_TRACE") ;
 
     if (continuous_trace)
       XDPPlugin::startWriteThread(XDPPlugin::get_trace_file_dump_int_s(), "VP_TRACE");
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Convert binary device trace to csv
+//
+// % xdp_trace_convert device_trace_0.bin [device_trace_0.csv]
+//
+// Binary device trace is written when xrt.ini sets
+// Debug.device_trace_format=binary.  The csv output is the same as
+// the device trace written with the default csv format, and can be
+// opened by existing trace viewers.
+
+#include "xdp/profile/writer/vp_base/DeviceTraceBinaryData.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: xdp_trace_convert <binary trace> [<csv trace>]\n"
+            << "  The csv trace defaults to the binary trace name with .csv extension\n";
+}
+
+static std::string
+csv_name(const std::string& binary)
+{
+  auto pos = binary.rfind(".bin");
+  return (pos != std::string::npos && pos + 4 == binary.size())
+    ? binary.substr(0, pos) + ".csv"
+    : binary + ".csv";
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  if (args.empty() || args.size() > 2 || args[0] == "-h") {
+    usage();
+    return;
+  }
+
+  auto csv = (args.size() == 2) ? args[1] : csv_name(args[0]);
+  xdp::AIEBinaryData::convertDeviceTrace(args[0], csv);
+  std::cout << "Wrote " << csv << '\n';
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved
+
+#define XDP_PLUGIN_SOURCE
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "core/common/message.h"
+#include "xdp/profile/writer/aie_trace/aie_trace_stream_writer.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+  // Trace words per buffer, 1MB of trace
+  constexpr size_t BUFFER_WORDS = 256 * 1024;
+
+  // Alignment of file writes with direct I/O
+  constexpr size_t IO_ALIGNMENT = 4096;
+
+  // Longest formatted word is "0xffffffff\n"
+  constexpr size_t MAX_WORD_CHARS = 11;
+
+  char* formatWord(char* out, uint32_t word)
+  {
+    static constexpr char digits[] = "0123456789abcdef";
+    *out++ = '0';
+    *out++ = 'x';
+    int shift = 28;
+    while (shift > 0 && ((word >> shift) & 0xf) == 0)
+      shift -= 4;
+    for (; shift >= 0; shift -= 4)
+      *out++ = digits[(word >> shift) & 0xf];
+    *out++ = '\n';
+    return out;
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  AIETraceStreamWriter::AIETraceStreamWriter(const char* filename, uint64_t devId,
+                                             uint64_t trStrmId, bool direct)
+    : VPWriter(filename),
+      deviceId(devId),
+      traceStreamId(trStrmId)
+  {
+    fill.reserve(BUFFER_WORDS);
+    drain.reserve(BUFFER_WORDS);
+
+    // Room for a formatted buffer, a partial block carried over from
+    // the previous buffer, and alignment of the start
+    textStorage.resize(BUFFER_WORDS * MAX_WORD_CHARS + 2 * IO_ALIGNMENT);
+    auto addr = reinterpret_cast<uintptr_t>(textStorage.data());
+    text = textStorage.data() + ((IO_ALIGNMENT - addr % IO_ALIGNMENT) % IO_ALIGNMENT);
+
+#ifndef _WIN32
+    // Write through a file descriptor rather than the stream opened by
+    // the base class, so that direct I/O can be used
+    fout.close();
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (direct) {
+      fd = ::open(getcurrentFileName().c_str(), flags | O_DIRECT, 0666);
+      directIO = (fd >= 0);
+    }
+    if (fd < 0)
+      fd = ::open(getcurrentFileName().c_str(), flags, 0666);
+#else
+    (void)direct;
+#endif
+
+    writerThread = std::thread(&AIETraceStreamWriter::writerLoop, this);
+  }
+
+  AIETraceStreamWriter::~AIETraceStreamWriter()
+  {
+    write(false);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    cv.notify_all();
+    writerThread.join();
+
+    // Same trailing line as AIETraceWriter
+    text[textSize++] = '\n';
+    writeText(true);
+
+    if (bytesWritten <= 1) {
+      std::string msg = "File: " + getcurrentFileName() + " (device #" + std::to_string(deviceId)
+          + ", stream #" + std::to_string(traceStreamId) + ") trace data was not captured.";
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
+    }
+
+#ifndef _WIN32
+    if (fd >= 0)
+      ::close(fd);
+#endif
+  }
+
+  // Hand fill buffer to writer thread once it is done with the drain
+  // buffer.  Called with lock held.
+  void AIETraceStreamWriter::submit(std::unique_lock<std::mutex>& lock)
+  {
+    cv.wait(lock, [this] { return !draining; });
+    std::swap(fill, drain);
+    draining = true;
+    cv.notify_all();
+  }
+
+  void AIETraceStreamWriter::append(const void* buffer, uint64_t bufferSz)
+  {
+    // Trace is always a whole number of words
+    auto words = static_cast<const uint32_t*>(buffer);
+    auto count = bufferSz / sizeof(uint32_t);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (count) {
+      auto n = std::min<uint64_t>(count, BUFFER_WORDS - fill.size());
+      fill.insert(fill.end(), words, words + n);
+      words += n;
+      count -= n;
+      if (fill.size() == BUFFER_WORDS)
+        submit(lock);
+    }
+  }
+
+  void AIETraceStreamWriter::writerLoop()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [this] { return draining || stop; });
+      if (!draining)
+        return;
+
+      // Offload keeps filling the other buffer while this one is written
+      lock.unlock();
+      format(drain);
+      writeText(false);
+      lock.lock();
+
+      drain.clear();
+      draining = false;
+      cv.notify_all();
+    }
+  }
+
+  void AIETraceStreamWriter::format(const std::vector<uint32_t>& words)
+  {
+    char* out = text + textSize;
+    for (auto word : words)
+      out = formatWord(out, word);
+    textSize = out - text;
+  }
+
+  // Write formatted text.  With direct I/O only whole blocks are
+  // written until the final write, the rest is carried over.
+  void AIETraceStreamWriter::writeText(bool final)
+  {
+    size_t size = textSize;
+#ifndef _WIN32
+    if (directIO && final) {
+      // The tail is not a whole block
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT);
+      directIO = false;
+    }
+    if (directIO)
+      size -= size % IO_ALIGNMENT;
+
+    size_t done = 0;
+    while (done < size) {
+      auto n = (fd >= 0) ? ::write(fd, text + done, size - done) : -1;
+      if (n <= 0) {
+        // Drop the trace rather than overflow the text buffer
+        bytesWritten += done;
+        textSize = 0;
+        return;
+      }
+      done += n;
+    }
+#else
+    fout.write(text, size);
+    if (final)
+      fout.flush();
+#endif
+
+    bytesWritten += size;
+    std::memmove(text, text + size, textSize - size);
+    textSize -= size;
+  }
+
+  bool AIETraceStreamWriter::write(bool openNewFile)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!fill.empty())
+      submit(lock);
+    cv.wait(lock, [this] { return !draining; });
+
+    // Trace is always appended to the same file
+    return !openNewFile;
+  }
+
+}
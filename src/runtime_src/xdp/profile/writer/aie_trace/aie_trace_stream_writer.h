@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved
+
+#ifndef AIE_TRACE_STREAM_WRITER_H
+#define AIE_TRACE_STREAM_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "xdp/profile/device/aie_trace/aie_trace_logger.h"
+#include "xdp/profile/writer/vp_base/vp_writer.h"
+
+namespace xdp {
+
+  // AIE trace of one stream written to file as it is offloaded
+  // (xrt.ini AIE_trace_settings.stream_to_file=true).
+  //
+  // Offloaded trace is copied into a fill buffer.  A full buffer is
+  // swapped with the drain buffer, which a writer thread formats and
+  // writes to file while offload continues.  Host memory is bounded
+  // by the two buffers, instead of holding all trace in the database
+  // until the end of the application.  The file content is the same
+  // as written by AIETraceWriter.
+  //
+  // With AIE_trace_settings.direct_io=true the file is opened with
+  // O_DIRECT on Linux, so trace does not accumulate in page cache.
+  class AIETraceStreamWriter : public VPWriter
+  {
+  private:
+    AIETraceStreamWriter() = delete ;
+
+    uint64_t deviceId;
+    uint64_t traceStreamId;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<uint32_t> fill;   // Appended by offload
+    std::vector<uint32_t> drain;  // Formatted and written by thread
+    bool draining = false;        // Drain buffer is being written
+    bool stop = false;
+    std::thread writerThread;
+
+    // Formatted trace not yet written, aligned for direct I/O
+    std::vector<char> textStorage;
+    char* text = nullptr;
+    size_t textSize = 0;
+    uint64_t bytesWritten = 0;
+
+    int fd = -1;
+    bool directIO = false;
+
+    void submit(std::unique_lock<std::mutex>& lock);
+    void writerLoop();
+    void format(const std::vector<uint32_t>& words);
+    void writeText(bool final);
+
+  public:
+    AIETraceStreamWriter(const char* filename, uint64_t devId,
+                         uint64_t trStrmId, bool direct);
+    ~AIETraceStreamWriter();
+
+    // Append trace, blocks only if both buffers are full
+    void append(const void* buffer, uint64_t bufferSz);
+
+    // Wait until all appended trace is written to file
+    virtual bool write(bool openNewFile);
+  };
+
+  // Logger that routes offloaded trace of each stream to its
+  // AIETraceStreamWriter instead of the database.  The writers are
+  // owned by the plugin and outlive the offloader using this logger.
+  class AIETraceStreamLogger : public AIETraceLogger
+  {
+  private:
+    std::vector<AIETraceStreamWriter*> writers;
+
+  public:
+    explicit AIETraceStreamLogger(std::vector<AIETraceStreamWriter*> w)
+      : writers(std::move(w))
+    {}
+
+    virtual void addAIETraceData(uint64_t strmIndex, void* buffer, uint64_t bufferSz, bool /*copy*/)
+    {
+      if (strmIndex < writers.size())
+        writers[strmIndex]->append(buffer, bufferSz);
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_PLUGIN_SOURCE
+
+#include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/device_events.h"
+#include "xdp/profile/writer/device_trace/device_trace_binary_writer.h"
+
+namespace {
+
+  // Large packets keep the per packet header and padding overhead low
+  constexpr uint32_t PACKET_SIZE = 64 * 1024;
+
+  // Text is split in records that fit in a packet with their type id,
+  //  flag, and terminating null
+  constexpr size_t MAX_TEXT_CHUNK =
+    PACKET_SIZE - sizeof(xdp::AIEBinaryData::PacketHeader) - 16;
+
+  xdp::AIEBinaryData::IBinaryDataEvent::Time toTime(double timestamp)
+  {
+    // Device timestamps are in ms, packet times are in ns
+    return static_cast<xdp::AIEBinaryData::IBinaryDataEvent::Time>(timestamp * 1.0e6);
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  DeviceTraceBinaryWriter::DeviceTraceBinaryWriter(const char* filename,
+                                                   uint64_t devId,
+                                                   const std::string& version,
+                                                   const std::string& creationTime,
+                                                   const std::string& xrtV,
+                                                   const std::string& toolV)
+    : DeviceTraceWriter(filename, devId, version, creationTime, xrtV, toolV)
+  {
+    // The base class opened the file as text.  Reopen it for binary
+    //  output and capture the text sections in a buffer instead.
+    fout.close();
+    fout.std::ios::rdbuf(&text);
+
+    stream.open(getcurrentFileName(), std::fstream::in | std::fstream::out |
+                                      std::fstream::binary | std::fstream::trunc);
+    binaryWriter = std::make_unique<AIEBinaryData::BinaryDataWriter>
+      (stream, (db->getStaticInfo()).getDeviceName(deviceId), 0,
+       (db->getStaticInfo()).getClockRateMHz(deviceId), PACKET_SIZE,
+       AIEBinaryData::DEVICE_TRACE_FILE_TYPE);
+  }
+
+  DeviceTraceBinaryWriter::~DeviceTraceBinaryWriter()
+  {
+    binaryWriter.reset();
+    fout.std::ios::rdbuf(nullptr);
+  }
+
+  void DeviceTraceBinaryWriter::writeText(const std::string& str)
+  {
+    textRecord.m_first = 1;
+    for (size_t pos = 0; pos < str.size(); pos += MAX_TEXT_CHUNK) {
+      textRecord.m_text = str.substr(pos, MAX_TEXT_CHUNK);
+      binaryWriter->writeEvent(lastTime, textRecord);
+      textRecord.m_first = 0;
+    }
+  }
+
+  void DeviceTraceBinaryWriter::writeEvent(VTFDeviceEvent* event, uint32_t bucket)
+  {
+    eventRecord.clear();
+    eventRecord.m_id        = event->getEventId();
+    eventRecord.m_startId   = event->getStartId();
+    eventRecord.m_timestamp = event->getTimestamp();
+    eventRecord.m_bucket    = bucket;
+    eventRecord.m_type      = event->getEventType();
+    if (auto memoryEvent = dynamic_cast<DeviceMemoryAccess*>(event))
+      eventRecord.m_extra.push_back(memoryEvent->getMemoryName());
+
+    lastTime = toTime(eventRecord.m_timestamp);
+    binaryWriter->writeEvent(lastTime, eventRecord);
+  }
+
+  void DeviceTraceBinaryWriter::writeKernelEvent(KernelEvent* event, uint32_t bucket,
+                                                 const std::vector<uint64_t>& toolTips)
+  {
+    eventRecord.clear();
+    eventRecord.m_id        = event->getEventId();
+    eventRecord.m_startId   = event->getStartId();
+    eventRecord.m_timestamp = event->getTimestamp();
+    eventRecord.m_bucket    = bucket;
+    eventRecord.m_type      = event->getEventType();
+    eventRecord.m_extra     = toolTips;
+
+    lastTime = toTime(eventRecord.m_timestamp);
+    binaryWriter->writeEvent(lastTime, eventRecord);
+  }
+
+  bool DeviceTraceBinaryWriter::write(bool openNewFile)
+  {
+    if (openNewFile && !traceEventsExist())
+      return false;
+
+    initialize();
+
+    // The header, structure, and string table are small compared to the
+    //  events and are appended in full on every write.  The converter
+    //  uses the last copy.
+    text.str("");
+    writeHeader();
+    fout << "\n";
+    writeStructure();
+    fout << "\n";
+    writeStringTable();
+    fout << "\n";
+    writeText(text.str());
+
+    writeTraceEvents();
+    binaryWriter->flush();
+
+    // All writes go to the same file, so there is never a new file
+    return !openNewFile;
+  }
+
+} // end namespace xdp
@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DEVICE_TRACE_BINARY_WRITER_DOT_H
+#define DEVICE_TRACE_BINARY_WRITER_DOT_H
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "xdp/profile/writer/device_trace/device_trace_writer.h"
+#include "xdp/profile/writer/vp_base/BinaryDataWriter.h"
+#include "xdp/profile/writer/vp_base/DeviceTraceBinaryData.h"
+
+namespace xdp {
+
+  // Device trace in the binary format of DeviceTraceBinaryData.h.
+  //  Every write appends the events moved out of the database since the
+  //  previous write to the same file, so continuous offload does not
+  //  open new files and no csv formatting happens at run time.  The
+  //  file is converted to csv offline with xdp_trace_convert.
+  class DeviceTraceBinaryWriter : public DeviceTraceWriter
+  {
+  private:
+    DeviceTraceBinaryWriter() = delete ;
+
+    std::fstream stream ;
+    std::unique_ptr<AIEBinaryData::BinaryDataWriter> binaryWriter ;
+
+    // The text sections of the trace are formatted by DeviceTraceWriter
+    //  into fout, which is redirected to this buffer
+    std::stringbuf text ;
+
+    AIEBinaryData::DeviceTraceEventRecord eventRecord ;
+    AIEBinaryData::DeviceTraceTextRecord textRecord ;
+    AIEBinaryData::IBinaryDataEvent::Time lastTime = 0 ;
+
+    void writeText(const std::string& str) ;
+
+  protected:
+    virtual void writeEvent(VTFDeviceEvent* event, uint32_t bucket) ;
+    virtual void writeKernelEvent(KernelEvent* event, uint32_t bucket,
+                                  const std::vector<uint64_t>& toolTips) ;
+
+  public:
+    DeviceTraceBinaryWriter(const char* filename, uint64_t deviceId,
+                            const std::string& version,
+                            const std::string& creationTime,
+                            const std::string& xrtV,
+                            const std::string& toolV);
+    ~DeviceTraceBinaryWriter() ;
+
+    virtual bool write(bool openNewFile) ;
+  } ;
+
+} // end namespace xdp
+
+#endif
@@ -336,6 +336,8 @@ namespace xdp {
     if (!xclbin)
       return;
 
+    std::vector<uint64_t> toolTips;
+
     for(auto& e : DeviceEvents) {
       VTFDeviceEvent* deviceEvent = dynamic_cast<VTFDeviceEvent*>(e.get());
       if(!deviceEvent)
@@ -358,29 +360,29 @@ namespace xdp {
           continue; // Coverity - In case dynamic cast fails
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        kernelEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
         // Also output the tool tips
+        toolTips.clear();
         for (const auto& iter : xclbin->pl.cus) {
           ComputeUnitInstance* cu = iter.second;
           if (cu->getAccelMon() == cuId) {
-            fout << "," << db->getDynamicInfo().addString(cu->getKernelName());
-            fout << "," << db->getDynamicInfo().addString(cu->getName());
+            toolTips.push_back(db->getDynamicInfo().addString(cu->getKernelName()));
+            toolTips.push_back(db->getDynamicInfo().addString(cu->getName()));
           }
         }
-        fout << "\n";
+        writeKernelEvent(kernelEvent, cuBucketIdMap[index] + eventType - KERNEL, toolTips);
       } else if(KERNEL_STALL_EXT_MEM == eventType
                 || KERNEL_STALL_DATAFLOW == eventType
                 || KERNEL_STALL_PIPE == eventType) {
         std::pair<XclbinInfo*, int32_t> index =
           std::make_pair(xclbin, cuId);
-        deviceEvent->dump(fout, cuBucketIdMap[index] + eventType - KERNEL);
+        writeEvent(deviceEvent, cuBucketIdMap[index] + eventType - KERNEL);
       } else {
         // Memory or Stream Acceses
         uint32_t monId = deviceEvent->getMonitorId();
         DeviceMemoryAccess* memoryEvent = dynamic_cast<DeviceMemoryAccess*>(e.get());
         if (memoryEvent) {
           std::pair<XclbinInfo*, uint32_t> index =std::make_pair(xclbin, monId);
-          deviceEvent->dump(fout, aimBucketIdMap[index] + eventType - KERNEL_READ);
+          writeEvent(deviceEvent, aimBucketIdMap[index] + eventType - KERNEL_READ);
           continue;
         }
         DeviceStreamAccess* streamEvent = dynamic_cast<DeviceStreamAccess*>(e.get());
@@ -388,9 +390,9 @@ namespace xdp {
           std::pair<XclbinInfo*, uint32_t> index = std::make_pair(xclbin, monId);
           if (KERNEL_STREAM_READ == eventType || KERNEL_STREAM_READ_STALL == eventType
                                               || KERNEL_STREAM_READ_STARVE == eventType) {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
+            writeEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_READ);
           } else {
-            deviceEvent->dump(fout, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
+            writeEvent(deviceEvent, asmBucketIdMap[index] + eventType - KERNEL_STREAM_WRITE);
           }
           continue;
         }
@@ -400,6 +402,20 @@ namespace xdp {
 
   }
 
+  void DeviceTraceWriter::writeEvent(VTFDeviceEvent* event, uint32_t bucket)
+  {
+    event->dump(fout, bucket);
+  }
+
+  void DeviceTraceWriter::writeKernelEvent(KernelEvent* event, uint32_t bucket,
+                                           const std::vector<uint64_t>& toolTips)
+  {
+    event->dump(fout, bucket);
+    for (auto toolTip : toolTips)
+      fout << "," << toolTip;
+    fout << "\n";
+  }
+
   void DeviceTraceWriter::writeDependencies()
   {
     fout << "DEPENDENCIES\n";
@@ -19,8 +19,10 @@
 #define HAL_DEVICE_TRACE_WRITER_DOT_H
 
 #include <string>
+#include <vector>
 
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/events/device_events.h"
 #include "xdp/profile/device/pl_device_intf.h"
 #include "xdp/profile/writer/vp_base/vp_trace_writer.h"
 
@@ -39,13 +41,6 @@ namespace xdp {
     std::map<std::pair<XclbinInfo*, uint32_t>, uint32_t> aimBucketIdMap;
     std::map<std::pair<XclbinInfo*, uint32_t>, uint32_t> asmBucketIdMap;
 
-    uint64_t deviceId;
-
-    // Helper function for making sure the database has enough information
-    //  to print out all of the information it will need.
-    void initialize() ;
-    bool traceEventsExist() ;
-
     // Helper functions for individual parts of the STRUCTURE section
     void writeDeviceStructure() ;
     void writeLoadedXclbinsStructure() ;
@@ -57,12 +52,25 @@ namespace xdp {
     void writeFloatingStreamTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount) ;
 
   protected:
+    uint64_t deviceId;
+
+    // Helper function for making sure the database has enough information
+    //  to print out all of the information it will need.
+    void initialize() ;
+    bool traceEventsExist() ;
+
     virtual void writeHeader() ;
     virtual void writeStructure() ;
     virtual void writeStringTable() ;
     virtual void writeTraceEvents() ;
     virtual void writeDependencies() ;
 
+    // Output of a single event in the given bucket (row).  Kernel events
+    //  are followed by the string table ids of their tool tips.
+    virtual void writeEvent(VTFDeviceEvent* event, uint32_t bucket) ;
+    virtual void writeKernelEvent(KernelEvent* event, uint32_t bucket,
+                                  const std::vector<uint64_t>& toolTips) ;
+
   public:
     DeviceTraceWriter(const char* filename, uint64_t deviceId, const std::string& version,
 		      const std::string& creationTime,
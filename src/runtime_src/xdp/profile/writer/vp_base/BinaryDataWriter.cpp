@@ -28,14 +28,14 @@ namespace xdp::AIEBinaryData
 {
 //---------------------------------------------------------------------------------------------------------------------
 BinaryDataWriter::BinaryDataWriter(std::fstream& stream,  const std::string& targetDevice, uint32_t hwGeneration,
-                                   double frequency, uint32_t packet_size)
+                                   double frequency, uint32_t packet_size, uint32_t file_type)
     : m_stream(stream), m_buffer(std::ios_base::in | std::ios_base::out | std::ios_base::binary),
       m_packageSize(packet_size)
 {
   time_t currentTime;
   m_header.setTargetDevice(targetDevice);
   m_header.m_hwGeneration = hwGeneration;
-  m_header.m_fileType    = 1;
+  m_header.m_fileType    = file_type;
   m_header.m_dataVersion = 1;
   m_header.m_frequency   = frequency;
   m_header.m_packageSize = packet_size;
@@ -53,7 +53,7 @@ void BinaryDataWriter::writeHeader()
 {
   m_stream.seekg(0, std::ios::beg);
   m_stream.write( reinterpret_cast<const char *>(&m_header), sizeof(m_header));
-  m_totalEventSize = PacketHeader::getPacketHeaderSize();;
+  m_totalEventSize = sizeof(PacketHeader);
 }
 //---------------------------------------------------------------------------------------------------------------------
 void BinaryDataWriter::writePacket(const char* content, uint32_t content_size, IBinaryDataEvent::Time timestamp_begin,
@@ -67,14 +67,16 @@ void BinaryDataWriter::writePacket(const char* content, uint32_t content_size, I
   if (content_size > 0)
     m_stream.write(content, content_size);
 
-  uint32_t padding_size = m_packageSize - sizeof(aPacketHeader) - content_size;
+  // A single event larger than a packet is written unpadded
+  uint32_t packet_size = sizeof(aPacketHeader) + content_size;
+  uint32_t padding_size = (packet_size < m_packageSize) ? m_packageSize - packet_size : 0;
   if (padding_size > 0) {
     void* pVoid = malloc(padding_size);
     memset(pVoid, 0, padding_size);
     m_stream.write((const char*)pVoid, padding_size);
     free(pVoid);
   }
-  m_totalEventSize = PacketHeader::getPacketHeaderSize();;
+  m_totalEventSize = sizeof(PacketHeader);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
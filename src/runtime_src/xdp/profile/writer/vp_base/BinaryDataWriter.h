@@ -35,7 +35,7 @@ class BinaryDataWriter : public IBinaryDataWriter
 {
 public:
   XDP_CORE_EXPORT BinaryDataWriter(std::fstream& channel, const std::string& targetDevice, uint32_t hwGeneration,
-                   double frequency, uint32_t packet_size);
+                   double frequency, uint32_t packet_size, uint32_t file_type = 1);
   XDP_CORE_EXPORT ~BinaryDataWriter() override;
 
 public:
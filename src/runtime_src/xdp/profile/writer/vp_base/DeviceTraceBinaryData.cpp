@@ -0,0 +1,281 @@
+/**
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include "BinaryDataHeader.h"
+#include "DeviceTraceBinaryData.h"
+#include "IBinaryDataWriter.h"
+#include "xdp/profile/database/events/device_events.h"
+
+namespace {
+
+using namespace xdp::AIEBinaryData;
+
+template <typename T>
+void readField(const char*& data, const char* end, T& value)
+{
+  if (static_cast<size_t>(end - data) < sizeof(T))
+    throw std::runtime_error("Truncated record in binary device trace");
+  std::memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+}
+
+// Call cb(typeID, data, end) for each record of each packet.  The
+// callback must read the record and advance data past it.  A packet
+// truncated at the end of the file is ignored.
+template <typename Callback>
+void readRecords(std::ifstream& in, uint32_t packageSize, Callback&& cb)
+{
+  std::vector<char> content;
+  PacketHeader packet;
+  while (in.read(reinterpret_cast<char*>(&packet), sizeof(packet))) {
+    if (!packet.isMagicNumberMatched())
+      throw std::runtime_error("Invalid packet in binary device trace");
+
+    content.resize(packet.m_content_size);
+    if (!in.read(content.data(), static_cast<std::streamsize>(content.size())))
+      return;
+
+    const char* data = content.data();
+    const char* end = data + content.size();
+    while (data < end) {
+      uint32_t typeID = 0;
+      readField(data, end, typeID);
+      cb(typeID, data, end);
+    }
+
+    // Packets are padded to the package size unless a single record
+    // did not fit
+    auto packetSize = sizeof(packet) + content.size();
+    if (packetSize < packageSize)
+      in.seekg(static_cast<std::streamoff>(packageSize - packetSize), std::ios::cur);
+  }
+}
+
+} // namespace
+
+namespace xdp::AIEBinaryData
+{
+//---------------------------------------------------------------------------------------------------------------------
+DeviceTraceEventRecord::DeviceTraceEventRecord(): IBinaryDataEvent(EventTypeID())
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+DeviceTraceEventRecord::~DeviceTraceEventRecord() = default;
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceEventRecord::clear()
+{
+  m_id        = 0;
+  m_startId   = 0;
+  m_timestamp = 0.0;
+  m_bucket    = 0;
+  m_type      = 0;
+  m_extra.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceEventRecord::print() const
+{
+  std::cout << m_id     << "," << m_startId << "," << m_timestamp << ",";
+  std::cout << m_bucket << "," << m_type;
+  for (auto extra : m_extra)
+    std::cout << "," << extra;
+  std::cout << std::endl;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint32_t DeviceTraceEventRecord::getSize() const
+{
+  uint32_t eventSize  = IBinaryDataEvent::getTypeIDSize();
+  eventSize += sizeof(m_id);
+  eventSize += sizeof(m_startId);
+  eventSize += sizeof(m_timestamp);
+  eventSize += sizeof(m_bucket);
+  eventSize += sizeof(uint16_t); // type
+  eventSize += sizeof(uint16_t); // number of extra fields
+  eventSize += static_cast<uint32_t>(m_extra.size() * sizeof(uint64_t));
+  return eventSize;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceEventRecord::writeFields(IBinaryDataWriter &writer) const
+{
+  auto type  = static_cast<uint16_t>(m_type);
+  auto count = static_cast<uint16_t>(m_extra.size());
+  IBinaryDataEvent::writeTypeID(writer);
+  writer.writeField((const char*) &m_id,        sizeof(uint64_t));
+  writer.writeField((const char*) &m_startId,   sizeof(uint64_t));
+  writer.writeField((const char*) &m_timestamp, sizeof(double));
+  writer.writeField((const char*) &m_bucket,    sizeof(uint32_t));
+  writer.writeField((const char*) &type,        sizeof(uint16_t));
+  writer.writeField((const char*) &count,       sizeof(uint16_t));
+  if (count)
+    writer.writeField((const char*) m_extra.data(), count * sizeof(uint64_t));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceEventRecord::readFields(const char*& data, const char* end)
+{
+  uint16_t type  = 0;
+  uint16_t count = 0;
+  readField(data, end, m_id);
+  readField(data, end, m_startId);
+  readField(data, end, m_timestamp);
+  readField(data, end, m_bucket);
+  readField(data, end, type);
+  readField(data, end, count);
+  m_type = type;
+  m_extra.resize(count);
+  for (auto& extra : m_extra)
+    readField(data, end, extra);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceEventRecord::dump(std::ofstream& fout) const
+{
+  // Format through the database event classes so the line is identical
+  // to the one written by DeviceTraceWriter.  KernelEvent does not end
+  // the line, which leaves room for the extra fields.
+  KernelEvent event(m_startId, m_timestamp, static_cast<VTFEventType>(m_type), 0, 0, -1);
+  event.setEventId(m_id);
+  event.dump(fout, m_bucket);
+  for (auto extra : m_extra)
+    fout << "," << extra;
+  fout << "\n";
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint32_t DeviceTraceEventRecord::EventTypeID()
+{
+  return 800;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+DeviceTraceTextRecord::DeviceTraceTextRecord(): IBinaryDataEvent(EventTypeID())
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+DeviceTraceTextRecord::~DeviceTraceTextRecord() = default;
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceTextRecord::clear()
+{
+  m_first = 0;
+  m_text.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceTextRecord::print() const
+{
+  std::cout << m_first << "," << m_text << std::endl;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint32_t DeviceTraceTextRecord::getSize() const
+{
+  uint32_t eventSize  = IBinaryDataEvent::getTypeIDSize();
+  eventSize += sizeof(m_first);
+  eventSize += static_cast<uint32_t>(m_text.size() + 1);
+  return eventSize;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceTextRecord::writeFields(IBinaryDataWriter &writer) const
+{
+  IBinaryDataEvent::writeTypeID(writer);
+  writer.writeField((const char*) &m_first, sizeof(uint32_t));
+  writer.writeField(m_text);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DeviceTraceTextRecord::readFields(const char*& data, const char* end)
+{
+  readField(data, end, m_first);
+  auto terminator = static_cast<const char*>(std::memchr(data, 0, end - data));
+  if (!terminator)
+    throw std::runtime_error("Truncated record in binary device trace");
+  m_text.assign(data, terminator);
+  data = terminator + 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint32_t DeviceTraceTextRecord::EventTypeID()
+{
+  return 801;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void convertDeviceTrace(const std::string& binaryFileName, const std::string& csvFileName)
+{
+  std::ifstream in(binaryFileName, std::ios::binary);
+  if (!in)
+    throw std::runtime_error("Unable to open " + binaryFileName);
+
+  BinaryDataHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || !header.isHeaderMatched() || header.m_fileType != DEVICE_TRACE_FILE_TYPE)
+    throw std::runtime_error(binaryFileName + " is not a binary device trace file");
+
+  std::ofstream fout(csvFileName);
+  if (!fout)
+    throw std::runtime_error("Unable to open " + csvFileName);
+
+  DeviceTraceEventRecord event;
+  DeviceTraceTextRecord text;
+
+  // First pass finds the most recent header, structure, and string
+  // table, which is a superset of the ones written before it
+  std::string sections;
+  readRecords(in, header.m_packageSize, [&](uint32_t typeID, const char*& data, const char* end) {
+    if (typeID == DeviceTraceEventRecord::EventTypeID()) {
+      event.readFields(data, end);
+    }
+    else if (typeID == DeviceTraceTextRecord::EventTypeID()) {
+      text.readFields(data, end);
+      if (text.m_first)
+        sections.clear();
+      sections += text.m_text;
+    }
+    else
+      throw std::runtime_error("Unknown record " + std::to_string(typeID) + " in binary device trace");
+  });
+  fout << sections;
+
+  // Second pass writes all events in the order they were written
+  in.clear();
+  in.seekg(sizeof(header), std::ios::beg);
+  fout << "EVENTS\n";
+  readRecords(in, header.m_packageSize, [&](uint32_t typeID, const char*& data, const char* end) {
+    if (typeID == DeviceTraceEventRecord::EventTypeID()) {
+      event.readFields(data, end);
+      event.dump(fout);
+    }
+    else
+      text.readFields(data, end);
+  });
+  fout << "\n";
+  fout << "DEPENDENCIES\n";
+  fout << "\n";
+}
+
+} // AIEBinaryData
@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2025 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BINARY_WRITER_XRT_DEVICETRACEBINARYDATA_H
+#define BINARY_WRITER_XRT_DEVICETRACEBINARYDATA_H
+
+#include "xdp/config.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "IBinaryDataEvent.h"
+
+// Records of the binary device trace format.
+//
+// A binary device trace file is a BinaryDataHeader with file type
+// DEVICE_TRACE_FILE_TYPE followed by fixed size packets of records.
+// Each write of the trace appends one text record holding the header,
+// structure, and string table sections of the csv trace, followed by
+// one event record per device event.  The csv trace is reconstructed
+// offline from the last text record and all event records.
+namespace xdp::AIEBinaryData
+{
+
+constexpr uint32_t DEVICE_TRACE_FILE_TYPE = 2;
+
+//---------------------------------------------------------------------------------------------------------------------
+class DeviceTraceEventRecord : public IBinaryDataEvent
+{
+public:
+  XDP_CORE_EXPORT DeviceTraceEventRecord();
+  XDP_CORE_EXPORT ~DeviceTraceEventRecord() override;
+
+public:
+  XDP_CORE_EXPORT void clear() override;
+  XDP_CORE_EXPORT void print() const override;
+  [[nodiscard]] XDP_CORE_EXPORT uint32_t getSize() const override;
+  XDP_CORE_EXPORT void writeFields(IBinaryDataWriter& writer) const override;
+
+  // Read fields following the type id, advance data past the record
+  XDP_CORE_EXPORT void readFields(const char*& data, const char* end);
+
+  // Write the record as a line of the EVENTS section of the csv trace
+  XDP_CORE_EXPORT void dump(std::ofstream& fout) const;
+
+public:
+  XDP_CORE_EXPORT static uint32_t EventTypeID();
+
+public:
+  uint64_t m_id        = 0;
+  uint64_t m_startId   = 0;
+  double   m_timestamp = 0.0;
+  uint32_t m_bucket    = 0;
+  uint32_t m_type      = 0;
+  std::vector<uint64_t> m_extra; ///< trailing string table ids of the event
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+class DeviceTraceTextRecord : public IBinaryDataEvent
+{
+public:
+  XDP_CORE_EXPORT DeviceTraceTextRecord();
+  XDP_CORE_EXPORT ~DeviceTraceTextRecord() override;
+
+public:
+  XDP_CORE_EXPORT void clear() override;
+  XDP_CORE_EXPORT void print() const override;
+  [[nodiscard]] XDP_CORE_EXPORT uint32_t getSize() const override;
+  XDP_CORE_EXPORT void writeFields(IBinaryDataWriter& writer) const override;
+
+  // Read fields following the type id, advance data past the record
+  XDP_CORE_EXPORT void readFields(const char*& data, const char* end);
+
+public:
+  XDP_CORE_EXPORT static uint32_t EventTypeID();
+
+public:
+  uint32_t    m_first = 0; ///< 1 if the first chunk of the text
+  std::string m_text;      ///< chunk of text, split to fit in packets
+};
+
+// Convert a binary device trace file to the csv device trace format.
+// Throws std::runtime_error if the file is not a binary device trace.
+XDP_CORE_EXPORT void convertDeviceTrace(const std::string& binaryFileName, const std::string& csvFileName);
+
+} // AIEBinaryData
+
+#endif //BINARY_WRITER_XRT_DEVICETRACEBINARYDATA_H
@@ -59,6 +59,9 @@ namespace xdp {
     addParameter("trace_file_dump_interval_s",
                  xrt_core::config::get_trace_file_dump_interval_s(),
                  "Interval for dumping files to host (in s)");              
+    addParameter("device_trace_format",
+                 xrt_core::config::get_device_trace_format(),
+                 "Format of device trace files: csv or binary");
     addParameter("lop_trace", xrt_core::config::get_lop_trace(),
                  "Generation of lower overhead OpenCL trace. Should not be used with other OpenCL options.");
     addParameter("debug_mode", xrt_core::config::get_launch_waveform(),
@@ -165,6 +168,12 @@ namespace xdp {
     addParameter("AIE_trace_settings.poll_timers_interval_us",
                  xrt_core::config::get_aie_trace_settings_poll_timers_interval_us(),
                  "Interval for polling AI Engine timers (in us)");
+    addParameter("AIE_trace_settings.stream_to_file",
+                 xrt_core::config::get_aie_trace_settings_stream_to_file(),
+                 "Write AI Engine trace to files as it is offloaded instead of at the end");
+    addParameter("AIE_trace_settings.direct_io",
+                 xrt_core::config::get_aie_trace_settings_direct_io(),
+                 "Bypass page cache when streaming AI Engine trace to files");
   }
 
   IniParameters::~IniParameters()
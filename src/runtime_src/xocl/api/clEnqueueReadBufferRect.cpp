@@ -29,16 +29,6 @@
 
 namespace xocl {
 
-inline size_t
-origin_in_bytes(const size_t* origin,
-                size_t        row_pitch,
-                size_t        slice_pitch)
-{
-  return origin[2] * slice_pitch
-       + origin[1] * row_pitch
-       + origin[0];
-}
-
 static void
 setIfZero(size_t& src_row_pitch,
           size_t& src_slice_pitch,
@@ -123,56 +113,22 @@ clEnqueueReadBufferRect(cl_command_queue     command_queue ,
                ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch
                ,ptr,num_events_in_wait_list ,event_wait_list,event);
 
-  size_t buffer_origin_in_bytes = origin_in_bytes(buffer_origin,
-                                                  buffer_row_pitch,
-                                                  buffer_slice_pitch);
-
-  size_t host_origin_in_bytes = origin_in_bytes(host_origin,host_row_pitch,
-                                                host_slice_pitch);
-
-  //allocate and aggregate event
-  if(event) {
+  // Soft event, aggregates the wait list also when no event is
+  // requested
+  auto context = xocl(command_queue)->get_context();
+  auto uevent = xocl::create_soft_event(context,CL_COMMAND_READ_BUFFER_RECT,num_events_in_wait_list,event_wait_list);
 
-    // Soft event
-    auto cmd = CL_COMMAND_WRITE_BUFFER_RECT;
-    auto context = xocl(command_queue)->get_context();
-    auto uevent = xocl::create_soft_event(context,cmd,num_events_in_wait_list,event_wait_list);
-
-    // this is a user visible event, user retains a reference
-    xocl::assign(event,uevent.get());
-
-    // queue the event, block until successfully submitted
-    xocl::xocl(*event)->queue(true /*wait*/);
-  }
+  // queue the event, block until successfully submitted
+  uevent->queue(true/*wait*/);
 
+  // Gather rows of the region, syncing from device only the range
+  // spanned by the region
   auto device = xocl::xocl(command_queue)->get_device();
-  auto boh = xocl::xocl(buffer)->get_buffer_object_or_error(device);
-  cl_int errc = 0;
-
-  // This is memory map is bigger than we could make it when start offsets is not 0, 0, 0.
-  void *host_ptr = clEnqueueMapBuffer(command_queue, buffer, true, CL_MAP_READ,
-                                      0, boh.size(), num_events_in_wait_list,
-                                      event_wait_list, nullptr, &errc);
-  if (errc)
-    return errc;
-
-  size_t yit, zit;
-  for (zit = 0; zit < region[2]; zit++) {
-    for (yit = 0; yit < region[1]; yit++) {
-      size_t buffer_row_origin_in_bytes = buffer_origin_in_bytes +
-                                          zit * buffer_slice_pitch +
-                                          yit * buffer_row_pitch;
-      size_t host_row_origin_in_bytes =
-          host_origin_in_bytes + zit * host_slice_pitch + yit * host_row_pitch;
-      memcpy(&((uint8_t *)(ptr))[host_row_origin_in_bytes],
-             &((uint8_t *)(host_ptr))[buffer_row_origin_in_bytes], region[0]);
-    }
-  }
-
-  clEnqueueUnmapMemObject(command_queue, buffer, host_ptr, 0, nullptr, nullptr);
-  if (event)
-    xocl::xocl(*event)->set_status(CL_COMPLETE);
+  device->read_buffer_rect(xocl(buffer),buffer_origin,host_origin,region
+                           ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch,ptr);
 
+  uevent->set_status(CL_COMPLETE);
+  xocl::assign(event,uevent.get());
   return CL_SUCCESS;
 }
 
@@ -31,6 +31,7 @@
 #include "core/common/xclbin_parser.h"
 #include "core/common/utils.h"
 
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -133,6 +134,49 @@ sync_to_hbuf(xocl::memory* buffer, size_t offset, size_t size,
   }
 }
 
+// Layout of a rectangular region in linear memory.  Zero pitches are
+// computed from the region as per OpenCL rect and image semantics.
+static xrt::bo::rect
+make_rect(const size_t* origin, const size_t* region, size_t row_pitch, size_t slice_pitch)
+{
+  if (!row_pitch)
+    row_pitch = region[0];
+  if (!slice_pitch)
+    slice_pitch = region[1] * row_pitch;
+  return {origin[2] * slice_pitch + origin[1] * row_pitch + origin[0], row_pitch, slice_pitch};
+}
+
+// Bytes from first to last byte of a region
+static size_t
+rect_extent(const xrt::bo::rect& rect, const std::array<size_t, 3>& region)
+{
+  if (!region[0] || !region[1] || !region[2])
+    return 0;
+  return (region[2] - 1) * rect.slice_pitch + (region[1] - 1) * rect.row_pitch + region[0];
+}
+
+// Call fn(offset, size) for each contiguous run of rows of a region
+template <typename Function>
+static void
+for_each_row_run(const xrt::bo::rect& rect, const std::array<size_t, 3>& region, Function&& fn)
+{
+  auto bytes = region[0];
+  auto rows = region[1];
+  auto slices = region[2];
+  if (rect.row_pitch == bytes) {
+    bytes *= rows;
+    rows = 1;
+    if (rect.slice_pitch == bytes) {
+      bytes *= slices;
+      slices = 1;
+    }
+  }
+
+  for (size_t z = 0; z < slices; ++z)
+    for (size_t y = 0; y < rows; ++y)
+      fn(rect.offset + z * rect.slice_pitch + y * rect.row_pitch, bytes);
+}
+
 static bool
 is_hw_emulation()
 {
@@ -636,6 +680,51 @@ read_buffer(memory* buffer, size_t offset, size_t size, void* ptr)
   sync_to_ubuf(buffer,offset,size,m_xdevice,boh);
 }
 
+void
+device::
+write_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin, const size_t* region,
+                  size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch,
+                  const void* ptr)
+{
+  auto boh = buffer->get_buffer_object(this);
+  auto bo_rect = make_rect(buffer_origin, region, buffer_row_pitch, buffer_slice_pitch);
+  auto host_rect = make_rect(host_origin, region, host_row_pitch, host_slice_pitch);
+  std::array<size_t, 3> rgn {region[0], region[1], region[2]};
+
+  // Scatter rows of ptr into buffer object
+  boh.write(ptr, host_rect, bo_rect, rgn);
+
+  // Update ubuf and device with the rows of the region only, the
+  // gaps between rows are not written
+  for_each_row_run(bo_rect, rgn, [&](size_t offset, size_t size) {
+    sync_to_ubuf(buffer,offset,size,m_xdevice,boh);
+  });
+  if (buffer->is_resident(this) && !buffer->no_host_memory())
+    boh.sync(XCL_BO_SYNC_BO_TO_DEVICE, bo_rect, rgn);
+}
+
+void
+device::
+read_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin, const size_t* region,
+                 size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch,
+                 void* ptr)
+{
+  auto boh = buffer->get_buffer_object(this);
+  auto bo_rect = make_rect(buffer_origin, region, buffer_row_pitch, buffer_slice_pitch);
+  auto host_rect = make_rect(host_origin, region, host_row_pitch, host_slice_pitch);
+  std::array<size_t, 3> rgn {region[0], region[1], region[2]};
+
+  // Sync back from device only the range spanned by the region
+  if (buffer->is_resident(this) && !buffer->no_host_memory())
+    boh.sync(XCL_BO_SYNC_BO_FROM_DEVICE, bo_rect, rgn);
+
+  // Gather rows of buffer object into ptr
+  boh.read(ptr, host_rect, bo_rect, rgn);
+
+  // Update ubuf if necessary
+  sync_to_ubuf(buffer,bo_rect.offset,rect_extent(bo_rect,rgn),m_xdevice,boh);
+}
+
 void
 device::
 copy_buffer(memory* src_buffer, memory* dst_buffer, size_t src_offset, size_t dst_offset, size_t size)
@@ -680,80 +769,55 @@ fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t off
   unmap_buffer(buffer,hbuf);
 }
 
-static void
-rw_image(device* device,
-         memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch
-         ,char* read_to,const char* write_from)
-{
-  auto boh = image->get_buffer_object(device);
-  auto xdevice = device->get_xdevice();
-
-  size_t image_offset = image->get_image_data_offset()
-    + image->get_image_bytes_per_pixel()*origin[0]
-    + image->get_image_row_pitch()*origin[1]
-    + image->get_image_slice_pitch()*origin[2];
-
-  if (!origin[0] && region[0]==image->get_image_width() && row_pitch==image->get_image_row_pitch()
-      && (region[2]==1
-          || (!origin[1] && region[1]==image->get_image_height() && slice_pitch==image->get_image_slice_pitch())
-          )
-      ) {
-    size_t sz = region[2]==1 ? row_pitch*region[1] : slice_pitch*region[2];
-    if (read_to)
-      xdevice->read(boh,read_to,sz,image_offset,false);
-    else
-      xdevice->write(boh,write_from,sz,image_offset,false);
-  }
-  else {
-    size_t image_offset_tmp = image_offset;
-    for (unsigned int j=0; j<region[2]; ++j) {
-      size_t offset = image_offset_tmp;
-      for (unsigned int i=0; i<region[1]; ++i) {
-        if (read_to) {
-          xdevice->read(boh,read_to,image->get_image_bytes_per_pixel()*region[0],offset,false);
-          read_to += row_pitch;
-        }
-        else {
-          xdevice->write(boh,write_from,image->get_image_bytes_per_pixel()*region[0],offset, false);
-          write_from += row_pitch;
-        }
-        offset += image->get_image_row_pitch();
-      }
-      image_offset_tmp += image->get_image_slice_pitch();
-      if (read_to)
-        read_to += slice_pitch;
-      else
-        write_from += slice_pitch;
-    }
-  }
+// Layout of image region in the image buffer object
+static xrt::bo::rect
+make_image_rect(const memory* image, const size_t* origin)
+{
+  return {image->get_image_data_offset()
+          + image->get_image_bytes_per_pixel() * origin[0]
+          + image->get_image_row_pitch() * origin[1]
+          + image->get_image_slice_pitch() * origin[2],
+          image->get_image_row_pitch(),
+          image->get_image_slice_pitch()};
+}
+
+// Region in bytes of an image region in pixels
+static std::array<size_t, 3>
+make_image_region(const memory* image, const size_t* region)
+{
+  return {image->get_image_bytes_per_pixel() * region[0], region[1], region[2]};
 }
 
 void
 device::
 write_image(memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch,const void *ptr)
 {
-  // Write from ptr into image
-  rw_image(this,image,origin,region,row_pitch,slice_pitch,nullptr,static_cast<const char*>(ptr));
+  auto boh = image->get_buffer_object(this);
+  auto image_rect = make_image_rect(image, origin);
+  auto image_region = make_image_region(image, region);
 
-  // Sync newly writte data to device if image is resident
-  if (image->is_resident(this) && !image->no_host_memory()) {
-    auto boh = image->get_buffer_object_or_error(this);
-    get_xdevice()->sync(boh, image->get_size(), 0,xrt_xocl::hal::device::direction::HOST2DEVICE,false);
-  }
+  // Scatter rows of ptr into image
+  boh.write(ptr, {0, row_pitch, slice_pitch}, image_rect, image_region);
+
+  // Sync the range spanned by the written region to device if image is resident
+  if (image->is_resident(this) && !image->no_host_memory())
+    boh.sync(XCL_BO_SYNC_BO_TO_DEVICE, image_rect, image_region);
 }
 
 void
 device::
 read_image(memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch,void *ptr)
 {
-  // Sync back from device if image is resident
-  if (image->is_resident(this) && !image->no_host_memory()) {
-    auto boh = image->get_buffer_object_or_error(this);
-    get_xdevice()->sync(boh,image->get_size(),0,xrt_xocl::hal::device::direction::DEVICE2HOST,false);
-  }
+  auto boh = image->get_buffer_object(this);
+  auto image_rect = make_image_rect(image, origin);
+  auto image_region = make_image_region(image, region);
+
+  // Sync back the range spanned by the region from device if image is resident
+  if (image->is_resident(this) && !image->no_host_memory())
+    boh.sync(XCL_BO_SYNC_BO_FROM_DEVICE, image_rect, image_region);
 
-  // Now read from image into ptr
-  rw_image(this,image,origin,region,row_pitch,slice_pitch,static_cast<char*>(ptr),nullptr);
+  // Gather rows of image into ptr
+  boh.read(ptr, {0, row_pitch, slice_pitch}, image_rect, image_region);
 }
 
 void
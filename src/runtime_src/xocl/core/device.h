@@ -413,6 +413,44 @@ public:
   void
   fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t offset, size_t size);
 
+  /**
+   * Write a rectangular region of host memory to buffer
+   *
+   * @param buffer
+   *  Buffer to write to.  The rows of the region are copied to the
+   *  underlying buffer object, which is synced to device in one
+   *  transfer of the range spanned by the region if and only if the
+   *  buffer is currently resident on the device.
+   * @param buffer_origin
+   *  Origin of region in buffer, x in bytes
+   * @param host_origin
+   *  Origin of region in host memory, x in bytes
+   * @param region
+   *  Width in bytes, height in rows, and depth in slices of region
+   * @param buffer_row_pitch, buffer_slice_pitch
+   *  Pitches of buffer in bytes, 0 if rows or slices are packed
+   * @param host_row_pitch, host_slice_pitch
+   *  Pitches of host memory in bytes, 0 if rows or slices are packed
+   * @param ptr
+   *  The host memory to write from
+   */
+  void
+  write_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin, const size_t* region,
+                    size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch,
+                    const void* ptr);
+
+  /**
+   * Read a rectangular region of buffer to host memory
+   *
+   * Same as write_buffer_rect() but in opposite direction.  The range
+   * spanned by the region is synced from device first if and only if
+   * the buffer is currently resident on the device.
+   */
+  void
+  read_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin, const size_t* region,
+                   size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch,
+                   void* ptr);
+
   void
   write_image(memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch,const void *ptr);
 
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+// Exercise strided xrt::bo read, write, and sync of a region of
+// interest.  Syncing a written region to device must not overwrite
+// device data in the gaps between rows.
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o bo_rect.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+static void
+usage()
+{
+    std::cout << "usage: %s [options]\n\n";
+    std::cout << "  -d <bdf | device_index>\n";
+    std::cout << "  [-g <memory group>] (default: 0)\n";
+    std::cout << "  -h\n\n";
+    std::cout << "";
+}
+
+template <typename Function>
+static void
+expect_throw(const std::string& what, Function&& f)
+{
+  try {
+    f();
+  }
+  catch (const std::exception&) {
+    return;
+  }
+  throw std::runtime_error(what + " did not throw");
+}
+
+static void
+run(const xrt::device& device, xrt::memory_group grp)
+{
+  // 4 rows of 16 bytes in a 8x32 byte image, 2 slices
+  constexpr size_t row_pitch = 32;
+  constexpr size_t slice_pitch = 8 * row_pitch;
+  constexpr size_t size = 2 * slice_pitch;
+  const std::array<size_t, 3> region {16, 4, 2};
+  const xrt::bo::rect bo_rect {2 * row_pitch + 8, row_pitch, slice_pitch};
+  const xrt::bo::rect src_rect {}; // packed
+
+  xrt::bo bo{device, size, grp};
+  auto bo_data = bo.map<uint8_t*>();
+
+  // Device content outside of the region
+  std::fill(bo_data, bo_data + size, 0xaa);
+  bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+  // Stale host content, not to be synced to device
+  std::fill(bo_data, bo_data + size, 0x55);
+
+  std::vector<uint8_t> src(region[0] * region[1] * region[2]);
+  for (size_t idx = 0; idx < src.size(); ++idx)
+    src[idx] = static_cast<uint8_t>(idx);
+
+  bo.write(src.data(), src_rect, bo_rect, region);
+  bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, bo_rect, region);
+
+  // Whole buffer from device, gaps must have device content
+  std::fill(bo_data, bo_data + size, 0);
+  bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  for (size_t offset = 0; offset < size; ++offset) {
+    auto z = offset / slice_pitch;
+    auto y = (offset % slice_pitch) / row_pitch;
+    auto x = offset % row_pitch;
+    bool in_region = z < region[2] && y >= 2 && y < 2 + region[1] && x >= 8 && x < 8 + region[0];
+    auto expected = in_region
+      ? src[(z * region[1] + (y - 2)) * region[0] + (x - 8)]
+      : uint8_t(0xaa);
+    if (bo_data[offset] != expected)
+      throw std::runtime_error("mismatch at offset " + std::to_string(offset));
+  }
+
+  // Strided read of region from device
+  std::fill(bo_data, bo_data + size, 0);
+  bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE, bo_rect, region);
+  std::vector<uint8_t> dst(src.size());
+  bo.read(dst.data(), src_rect, bo_rect, region);
+  if (dst != src)
+    throw std::runtime_error("strided read mismatch");
+
+  // Pitches too small for the region
+  expect_throw("row pitch", [&] {
+    bo.write(src.data(), src_rect, {0, region[0] - 1, 0}, region);
+  });
+  expect_throw("slice pitch", [&] {
+    bo.read(dst.data(), src_rect, {0, row_pitch, row_pitch * region[1] - 1}, region);
+  });
+  expect_throw("sync pitch", [&] {
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, {0, region[0] - 1, 0}, region);
+  });
+  expect_throw("region past end", [&] {
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, {size - region[0] + 1, row_pitch, slice_pitch}, region);
+  });
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 2) {
+    usage();
+    return 1;
+  }
+
+  std::string device_index = "0";
+  xrt::memory_group grp = 0;
+
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-d")
+      device_index = arg;
+    else if (cur == "-g")
+      grp = static_cast<xrt::memory_group>(std::stoul(arg));
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  run(xrt::device(device_index), grp);
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& e) {
+    std::cout << "Exception: " << e.what() << "\n";
+    std::cout << "FAILED TEST\n";
+    return 1;
+  }
+}
@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef perf_host_bench_h
+#define perf_host_bench_h
+
+// Helpers shared by the host stack benchmarks
+//
+// The benchmarks run against the noop shim (XCL_EMULATION_MODE=noop),
+// which completes commands without a device, so the measured time is
+// the cost of the XRT host stack only.  The xclbin is synthesized in
+// memory with just enough meta data to create kernels and buffers.
+
+#include "xrt/detail/xclbin.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Synthetic kernel 'bench' with arguments (in, out, count)
+constexpr const char* kernel_name = "bench";
+
+// create_xclbin() - Synthesize an xclbin with one kernel of 'cus' CUs
+//
+// The kernel has two global memory arguments connected to a single
+// DDR bank and one scalar argument.  All CUs are AP_CTRL_HS.
+inline std::vector<char>
+create_xclbin(size_t cus)
+{
+  std::ostringstream xml;
+  xml << "<project name=\"perf_host\"><platform><device name=\"fpga0\" fpgaDevice=\"noop\"><core>"
+      << "<kernel name=\"" << kernel_name << "\" language=\"c\" type=\"pl\">"
+      << "<port name=\"M_AXI_GMEM\" mode=\"master\" range=\"0xFFFFFFFF\" dataWidth=\"512\"/>"
+      << "<port name=\"S_AXI_CONTROL\" mode=\"slave\" range=\"0x1000\" dataWidth=\"32\"/>"
+      << "<arg name=\"in\" addressQualifier=\"1\" id=\"0\" port=\"M_AXI_GMEM\" size=\"0x8\""
+      << " offset=\"0x10\" hostOffset=\"0x0\" hostSize=\"0x8\" type=\"int*\"/>"
+      << "<arg name=\"out\" addressQualifier=\"1\" id=\"1\" port=\"M_AXI_GMEM\" size=\"0x8\""
+      << " offset=\"0x1c\" hostOffset=\"0x0\" hostSize=\"0x8\" type=\"int*\"/>"
+      << "<arg name=\"count\" addressQualifier=\"0\" id=\"2\" port=\"S_AXI_CONTROL\" size=\"0x4\""
+      << " offset=\"0x28\" hostOffset=\"0x0\" hostSize=\"0x4\" type=\"unsigned int\"/>";
+  for (size_t cu = 0; cu < cus; ++cu)
+    xml << "<instance name=\"" << kernel_name << "_" << cu + 1 << "\">"
+        << "<addrRemap base=\"0x" << std::hex << (0x1800000 + 0x10000 * cu) << std::dec
+        << "\" range=\"0x10000\" port=\"S_AXI_CONTROL\"/></instance>";
+  xml << "</kernel></core></device></platform></project>";
+  auto metadata = xml.str();
+
+  std::vector<char> topology(sizeof(mem_topology));
+  auto topo = reinterpret_cast<mem_topology*>(topology.data());
+  topo->m_count = 1;
+  topo->m_mem_data[0].m_type = MEM_DDR4;
+  topo->m_mem_data[0].m_used = 1;
+  topo->m_mem_data[0].m_size = 0x400000;  // KB
+  topo->m_mem_data[0].m_base_address = 0x4000000000;
+  std::strncpy(reinterpret_cast<char*>(topo->m_mem_data[0].m_tag), "bank0", sizeof(topo->m_mem_data[0].m_tag));
+
+  std::vector<char> layout(sizeof(ip_layout) + (cus - 1) * sizeof(ip_data));
+  auto ips = reinterpret_cast<ip_layout*>(layout.data());
+  ips->m_count = static_cast<int32_t>(cus);
+  for (size_t cu = 0; cu < cus; ++cu) {
+    auto& ip = ips->m_ip_data[cu];
+    ip.m_type = IP_KERNEL;
+    ip.properties = (AP_CTRL_HS << 8) | IP_INT_ENABLE_MASK;
+    ip.m_base_address = 0x1800000 + 0x10000 * cu;
+    auto name = std::string{kernel_name} + ":" + kernel_name + "_" + std::to_string(cu + 1);
+    std::strncpy(reinterpret_cast<char*>(ip.m_name), name.c_str(), sizeof(ip.m_name) - 1);
+  }
+
+  std::vector<char> connections(sizeof(connectivity) + (2 * cus - 1) * sizeof(connection));
+  auto conn = reinterpret_cast<connectivity*>(connections.data());
+  conn->m_count = static_cast<int32_t>(2 * cus);
+  for (size_t cu = 0; cu < cus; ++cu) {
+    for (int32_t arg = 0; arg < 2; ++arg) {
+      auto& c = conn->m_connection[2 * cu + arg];
+      c.arg_index = arg;
+      c.m_ip_layout_index = static_cast<int32_t>(cu);
+      c.mem_data_index = 0;
+    }
+  }
+
+  std::vector<std::pair<axlf_section_kind, std::vector<char>>> sections;
+  sections.emplace_back(EMBEDDED_METADATA, std::vector<char>(metadata.begin(), metadata.end()));
+  sections.emplace_back(MEM_TOPOLOGY, std::move(topology));
+  sections.emplace_back(IP_LAYOUT, std::move(layout));
+  sections.emplace_back(CONNECTIVITY, std::move(connections));
+
+  auto align = [](size_t sz) { return (sz + 7) & ~size_t(7); };
+  auto offset = align(sizeof(axlf) + (sections.size() - 1) * sizeof(axlf_section_header));
+  auto length = offset;
+  for (const auto& section : sections)
+    length += align(section.second.size());
+
+  std::vector<char> data(length, 0);
+  auto top = reinterpret_cast<axlf*>(data.data());
+  std::memcpy(top->m_magic, "xclbin2", sizeof("xclbin2"));
+  top->m_signature_length = -1;
+  std::memset(top->reserved, 0xFF, sizeof(top->reserved));
+  top->m_header.m_length = length;
+  top->m_header.m_versionMajor = 2;
+  top->m_header.m_mode = XCLBIN_FLAT;
+  std::strncpy(reinterpret_cast<char*>(top->m_header.m_platformVBNV), "xilinx_noop_perf_host",
+               sizeof(top->m_header.m_platformVBNV) - 1);
+
+  // Fixed uuid derived from number of CUs, such that xclbins with
+  // different CU counts can co-exist in one process
+  for (size_t i = 0; i < sizeof(top->m_header.uuid); ++i)
+    top->m_header.uuid[i] = static_cast<unsigned char>(0xb0 + i + cus);
+
+  top->m_header.m_numSections = static_cast<uint32_t>(sections.size());
+  for (size_t idx = 0; idx < sections.size(); ++idx) {
+    auto& hdr = top->m_sections[idx];
+    const auto& [kind, payload] = sections[idx];
+    hdr.m_sectionKind = kind;
+    hdr.m_sectionOffset = offset;
+    hdr.m_sectionSize = payload.size();
+    std::memcpy(data.data() + offset, payload.data(), payload.size());
+    offset += align(payload.size());
+  }
+
+  return data;
+}
+
+// struct result - Throughput and latency of one benchmark configuration
+struct result
+{
+  std::string name;
+  size_t threads = 0;
+  uint64_t ops = 0;          // operations across all threads
+  double seconds = 0;        // wall time of measured section
+  double p50 = 0;            // latency percentiles of one call (us)
+  double p90 = 0;
+  double p99 = 0;
+  double max = 0;
+};
+
+inline double
+percentile(const std::vector<uint64_t>& sorted, double pct)
+{
+  if (sorted.empty())
+    return 0;
+  auto idx = static_cast<size_t>(pct / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)] / 1000.0;
+}
+
+// measure() - Run an operation from multiple threads
+//
+// @name:        name of benchmark in report
+// @threads:     number of concurrent threads
+// @iterations:  calls of the operation per thread
+// @ops_per_call: operations accounted for by one call, e.g. size of runlist
+// @make:        creates a per thread callable, called with thread index
+//
+// Per thread state is constructed by 'make' and warmed up with 5% of
+// the iterations before the clock starts, after which all threads are
+// released at once.
+template <typename MakeOp>
+inline result
+measure(const std::string& name, size_t threads, size_t iterations, size_t ops_per_call, MakeOp&& make)
+{
+  using clock = std::chrono::steady_clock;
+  std::vector<std::vector<uint64_t>> samples(threads);
+  std::vector<std::exception_ptr> errors(threads);
+  std::atomic<size_t> ready{0};
+  std::atomic<bool> go{false};
+  auto warmup = iterations / 20;
+
+  auto worker = [&](size_t tidx) {
+    auto& lat = samples[tidx];
+    try {
+      auto op = make(tidx);
+      lat.reserve(iterations);
+      for (size_t i = 0; i < warmup; ++i)
+        op();
+
+      ++ready;
+      while (!go)
+        std::this_thread::yield();
+
+      for (size_t i = 0; i < iterations; ++i) {
+        auto start = clock::now();
+        op();
+        auto end = clock::now();
+        lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+      }
+    }
+    catch (...) {
+      // Count as ready if failure happened before the barrier
+      errors[tidx] = std::current_exception();
+      if (!go)
+        ++ready;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (size_t t = 0; t < threads; ++t)
+    workers.emplace_back(worker, t);
+
+  while (ready < threads)
+    std::this_thread::yield();
+
+  auto start = clock::now();
+  go = true;
+  for (auto& w : workers)
+    w.join();
+  auto end = clock::now();
+
+  for (auto& err : errors)
+    if (err)
+      std::rethrow_exception(err);
+
+  std::vector<uint64_t> all;
+  for (auto& lat : samples)
+    all.insert(all.end(), lat.begin(), lat.end());
+  std::sort(all.begin(), all.end());
+
+  result r;
+  r.name = name;
+  r.threads = threads;
+  r.ops = all.size() * ops_per_call;
+  r.seconds = std::chrono::duration<double>(end - start).count();
+  r.p50 = percentile(all, 50);
+  r.p90 = percentile(all, 90);
+  r.p99 = percentile(all, 99);
+  r.max = percentile(all, 100);
+  return r;
+}
+
+inline void
+print_header(bool csv)
+{
+  if (csv) {
+    std::cout << "benchmark,threads,ops,ops_per_sec,p50_us,p90_us,p99_us,max_us\n";
+    return;
+  }
+
+  std::cout << std::left << std::setw(16) << "benchmark" << std::right
+            << std::setw(8) << "threads" << std::setw(12) << "ops"
+            << std::setw(14) << "ops/s" << std::setw(10) << "p50(us)"
+            << std::setw(10) << "p90(us)" << std::setw(10) << "p99(us)"
+            << std::setw(12) << "max(us)" << '\n';
+}
+
+// print() - Print one result row
+inline void
+print(const result& r, bool csv)
+{
+  auto ops_per_sec = r.seconds > 0 ? r.ops / r.seconds : 0;
+  if (csv) {
+    std::cout << r.name << ',' << r.threads << ',' << r.ops << ',' << std::fixed
+              << std::setprecision(0) << ops_per_sec << std::setprecision(2)
+              << ',' << r.p50 << ',' << r.p90 << ',' << r.p99 << ',' << r.max << '\n'
+              << std::defaultfloat;
+    return;
+  }
+
+  std::cout << std::left << std::setw(16) << r.name << std::right
+            << std::setw(8) << r.threads << std::setw(12) << r.ops
+            << std::fixed << std::setprecision(0) << std::setw(14) << ops_per_sec
+            << std::setprecision(2) << std::setw(10) << r.p50
+            << std::setw(10) << r.p90 << std::setw(10) << r.p99
+            << std::setw(12) << r.max << '\n' << std::defaultfloat;
+}
+
+// parse_threads() - Parse comma separated list of thread counts
+inline std::vector<size_t>
+parse_threads(const std::string& arg)
+{
+  std::vector<size_t> threads;
+  std::istringstream is(arg);
+  std::string tok;
+  while (std::getline(is, tok, ','))
+    threads.push_back(std::stoul(tok));
+  if (threads.empty() || std::find(threads.begin(), threads.end(), 0) != threads.end())
+    throw std::runtime_error("Invalid thread list: " + arg);
+  return threads;
+}
+
+} // bench
+
+#endif
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Host stack IOPS and latency benchmark for XRT OpenCL
+//
+// % XCL_EMULATION_MODE=noop ./ocl_bench [options]
+//
+// Same synthetic xclbin and reporting as xrt_bench, but measures the
+// OpenCL enqueue path of XRT.  Each thread uses its own in-order
+// command queue and cl_kernel within one shared context.
+#include "bench.h"
+
+#include <CL/cl.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: ocl_bench [options]\n"
+            << " [-b <benchmark>] run this benchmark, repeat to select several (default all)\n"
+            << "                  task, migrate, write\n"
+            << " [-t <threads>] comma separated list of thread counts (default 1,2,4,8)\n"
+            << " [-i <iterations>] calls per thread (default 10000)\n"
+            << " [-s <bytes>] size of buffers (default 4096)\n"
+            << " [-c] print results as csv\n"
+            << "\n"
+            << "Run with XCL_EMULATION_MODE=noop to measure the host stack only.\n";
+}
+
+static void
+throw_if_error(cl_int errcode, const char* msg)
+{
+  if (errcode != CL_SUCCESS)
+    throw std::runtime_error(std::string(msg) + " failed with errcode " + std::to_string(errcode));
+}
+
+struct options
+{
+  std::set<std::string> benchmarks;
+  std::vector<size_t> threads {1, 2, 4, 8};
+  size_t iterations = 10000;  // NOLINT
+  size_t bytes = 4096;        // NOLINT
+  bool csv = false;
+
+  bool
+  selected(const std::string& name) const
+  {
+    return benchmarks.empty() || benchmarks.count(name);
+  }
+};
+
+// Shared context and program with the synthetic xclbin
+struct program
+{
+  cl_device_id device = nullptr;
+  cl_context context = nullptr;
+  cl_program prog = nullptr;
+
+  explicit
+  program(const std::vector<char>& xclbin)
+  {
+    cl_uint num_platforms = 0;
+    throw_if_error(clGetPlatformIDs(0, nullptr, &num_platforms), "clGetPlatformIDs");
+    std::vector<cl_platform_id> platforms(num_platforms);
+    throw_if_error(clGetPlatformIDs(num_platforms, platforms.data(), nullptr), "clGetPlatformIDs");
+
+    for (auto platform : platforms) {
+      char vendor[256] = {0};
+      clGetPlatformInfo(platform, CL_PLATFORM_VENDOR, sizeof(vendor) - 1, vendor, nullptr);
+      if (std::string(vendor).find("Xilinx") == std::string::npos)
+        continue;
+      throw_if_error(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ACCELERATOR, 1, &device, nullptr), "clGetDeviceIDs");
+      break;
+    }
+    if (!device)
+      throw std::runtime_error("No Xilinx OpenCL device found");
+
+    cl_int err = CL_SUCCESS;
+    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+    throw_if_error(err, "clCreateContext");
+
+    auto size = xclbin.size();
+    auto data = reinterpret_cast<const unsigned char*>(xclbin.data());
+    prog = clCreateProgramWithBinary(context, 1, &device, &size, &data, nullptr, &err);
+    throw_if_error(err, "clCreateProgramWithBinary");
+    throw_if_error(clBuildProgram(prog, 1, &device, nullptr, nullptr, nullptr), "clBuildProgram");
+  }
+
+  ~program()
+  {
+    clReleaseProgram(prog);
+    clReleaseContext(context);
+  }
+
+  program(const program&) = delete;
+  program& operator=(const program&) = delete;
+};
+
+// Per thread queue, kernel, and buffers
+struct thread_state
+{
+  cl_command_queue queue = nullptr;
+  cl_kernel kernel = nullptr;
+  cl_mem in = nullptr;
+  cl_mem out = nullptr;
+  std::vector<char> host;
+
+  thread_state(const program& p, size_t bytes)
+    : host(bytes)
+  {
+    cl_int err = CL_SUCCESS;
+    queue = clCreateCommandQueue(p.context, p.device, 0, &err);
+    throw_if_error(err, "clCreateCommandQueue");
+    kernel = clCreateKernel(p.prog, bench::kernel_name, &err);
+    throw_if_error(err, "clCreateKernel");
+    in = clCreateBuffer(p.context, CL_MEM_READ_ONLY, bytes, nullptr, &err);
+    throw_if_error(err, "clCreateBuffer");
+    out = clCreateBuffer(p.context, CL_MEM_WRITE_ONLY, bytes, nullptr, &err);
+    throw_if_error(err, "clCreateBuffer");
+
+    cl_uint count = static_cast<cl_uint>(bytes / sizeof(int));
+    throw_if_error(clSetKernelArg(kernel, 0, sizeof(cl_mem), &in), "clSetKernelArg");
+    throw_if_error(clSetKernelArg(kernel, 1, sizeof(cl_mem), &out), "clSetKernelArg");
+    throw_if_error(clSetKernelArg(kernel, 2, sizeof(cl_uint), &count), "clSetKernelArg");
+  }
+
+  ~thread_state()
+  {
+    clReleaseMemObject(out);
+    clReleaseMemObject(in);
+    clReleaseKernel(kernel);
+    clReleaseCommandQueue(queue);
+  }
+
+  thread_state(const thread_state&) = delete;
+  thread_state& operator=(const thread_state&) = delete;
+};
+
+// task - enqueue kernel and wait for completion
+static bench::result
+bench_task(const program& p, size_t threads, const options& opt)
+{
+  return bench::measure("ocl-task", threads, opt.iterations, 1, [&](size_t) {
+    auto s = std::make_shared<thread_state>(p, opt.bytes);
+    return [s] {
+      throw_if_error(clEnqueueTask(s->queue, s->kernel, 0, nullptr, nullptr), "clEnqueueTask");
+      throw_if_error(clFinish(s->queue), "clFinish");
+    };
+  });
+}
+
+// migrate - migrate buffers to and from device
+static bench::result
+bench_migrate(const program& p, size_t threads, const options& opt)
+{
+  return bench::measure("ocl-migrate", threads, opt.iterations, 2, [&](size_t) {
+    auto s = std::make_shared<thread_state>(p, opt.bytes);
+    return [s] {
+      throw_if_error(clEnqueueMigrateMemObjects(s->queue, 1, &s->in, 0, 0, nullptr, nullptr), "clEnqueueMigrateMemObjects");
+      throw_if_error(clEnqueueMigrateMemObjects(s->queue, 1, &s->out, CL_MIGRATE_MEM_OBJECT_HOST, 0, nullptr, nullptr), "clEnqueueMigrateMemObjects");
+      throw_if_error(clFinish(s->queue), "clFinish");
+    };
+  });
+}
+
+// write - blocking write of host data to buffer
+static bench::result
+bench_write(const program& p, size_t threads, const options& opt)
+{
+  return bench::measure("ocl-write", threads, opt.iterations, 1, [&](size_t) {
+    auto s = std::make_shared<thread_state>(p, opt.bytes);
+    return [s] {
+      throw_if_error(clEnqueueWriteBuffer(s->queue, s->in, CL_TRUE, 0, s->host.size(), s->host.data(), 0, nullptr, nullptr), "clEnqueueWriteBuffer");
+    };
+  });
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  options opt;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg == "-c") {
+      opt.csv = true;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-b")
+      opt.benchmarks.insert(arg);
+    else if (cur == "-t")
+      opt.threads = bench::parse_threads(arg);
+    else if (cur == "-i")
+      opt.iterations = std::stoul(arg);
+    else if (cur == "-s")
+      opt.bytes = std::stoul(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (!std::getenv("XCL_EMULATION_MODE"))
+    std::cout << "Warning: XCL_EMULATION_MODE is not set, measuring with device\n";
+
+  auto max_threads = *std::max_element(opt.threads.begin(), opt.threads.end());
+  program p{bench::create_xclbin(max_threads)};
+
+  using bench_fn = bench::result (*)(const program&, size_t, const options&);
+  const std::vector<std::pair<std::string, bench_fn>> benchmarks = {
+    {"task", bench_task},
+    {"migrate", bench_migrate},
+    {"write", bench_write},
+  };
+
+  bench::print_header(opt.csv);
+  for (const auto& [name, fn] : benchmarks) {
+    if (!opt.selected(name))
+      continue;
+    for (auto threads : opt.threads)
+      bench::print(fn(p, threads, opt), opt.csv);
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}
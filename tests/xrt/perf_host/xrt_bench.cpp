@@ -0,0 +1,373 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+// Host stack IOPS and latency benchmark for XRT native APIs
+//
+// % XCL_EMULATION_MODE=noop ./xrt_bench [options]
+//
+// The benchmark synthesizes an xclbin and measures host side cost of
+// xrt::run start/wait and relaunch with changed arguments, scalar
+// xrt::run::set_arg, xrt::runlist, xrt::submit_batch, xrt::queue, xrt::bo::sync,
+// xrt::sync_many, and xrt::runner execution for each requested thread count.  With the
+// noop shim commands complete immediately unless
+// Runtime.noop_completion_delay_us is set in xrt.ini.  With
+// Runtime.command_trace=true the host latency of the most recent
+// commands is broken down by stage.
+
+#include "bench.h"
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "xrt/experimental/xrt_kernel.h"
+#include "xrt/experimental/xrt_queue.h"
+#include "xrt/experimental/xrt_xclbin.h"
+
+#include "core/common/api/command_trace.h"
+#include "core/common/runner/runner.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+# pragma warning (disable: 4100)
+#endif
+
+static void
+usage()
+{
+  std::cout << "usage: xrt_bench [options]\n"
+            << " [-b <benchmark>] run this benchmark, repeat to select several (default all)\n"
+            << "                  run, relaunch, set_arg, runlist, batch, queue, sync, sync_many, runner\n"
+            << " [-t <threads>] comma separated list of thread counts (default 1,2,4,8)\n"
+            << " [-i <iterations>] calls per thread (default 10000)\n"
+            << " [-r <runs>] runs per runlist or batch, slices per sync_many, sets per set_arg (default 24)\n"
+            << " [-s <bytes>] size of buffers (default 4096)\n"
+            << " [-c] print results as csv\n"
+            << " [-d <device>] device index (default 0)\n"
+            << "\n"
+            << "Run with XCL_EMULATION_MODE=noop to measure the host stack only.\n";
+}
+
+struct options
+{
+  std::set<std::string> benchmarks;
+  std::vector<size_t> threads {1, 2, 4, 8};
+  size_t iterations = 10000;  // NOLINT
+  size_t runs = 24;           // NOLINT
+  size_t bytes = 4096;        // NOLINT
+  unsigned int device_index = 0;
+  bool csv = false;
+
+  bool
+  selected(const std::string& name) const
+  {
+    return benchmarks.empty() || benchmarks.count(name);
+  }
+};
+
+// Per thread run object of the synthetic kernel with buffers
+struct kernel_run
+{
+  xrt::bo in;
+  xrt::bo out;
+  xrt::run run;
+
+  kernel_run(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t bytes)
+    : in(hwctx, bytes, kernel.group_id(0))
+    , out(hwctx, bytes, kernel.group_id(1))
+    , run{kernel}
+  {
+    run.set_arg(0, in);
+    run.set_arg(1, out);
+    run.set_arg(2, static_cast<unsigned int>(bytes / sizeof(int)));
+  }
+};
+
+// run - start and wait for one run object
+static bench::result
+bench_run(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  return bench::measure("run", threads, opt.iterations, 1, [&](size_t) {
+    auto kr = std::make_shared<kernel_run>(hwctx, kernel, opt.bytes);
+    return [kr] {
+      kr->run.start();
+      kr->run.wait();
+    };
+  });
+}
+
+// relaunch - set all arguments with only one buffer changing, then
+// start and wait; arguments set to their current value are not
+// re-encoded
+static bench::result
+bench_relaunch(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  struct state
+  {
+    kernel_run kr;
+    xrt::bo out2;
+    size_t count = 0;
+  };
+
+  return bench::measure("relaunch", threads, opt.iterations, 1, [&](size_t) {
+    auto s = std::make_shared<state>(state{kernel_run{hwctx, kernel, opt.bytes},
+                                           xrt::bo(hwctx, opt.bytes, kernel.group_id(1))});
+    return [s] {
+      auto& kr = s->kr;
+      kr.run.set_arg(0, kr.in);
+      kr.run.set_arg(1, (++s->count % 2) ? s->out2 : kr.out);
+      kr.run.set_arg(2, static_cast<unsigned int>(kr.in.size() / sizeof(int)));
+      kr.run.start();
+      kr.run.wait();
+    };
+  });
+}
+
+// set_arg - set the scalar argument of a run object, compare with
+// xrt.ini Runtime.typed_arg_encoding=false for the generic path
+static bench::result
+bench_set_arg(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  return bench::measure("set_arg", threads, opt.iterations, opt.runs, [&](size_t) {
+    auto kr = std::make_shared<kernel_run>(hwctx, kernel, opt.bytes);
+    return [kr, runs = opt.runs] {
+      for (unsigned int value = 0; value < runs; ++value)
+        kr->run.set_arg(2, value);
+    };
+  });
+}
+
+// runlist - execute and wait for a list of run objects
+static bench::result
+bench_runlist(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  struct state
+  {
+    std::vector<kernel_run> runs;
+    xrt::runlist runlist;
+  };
+
+  return bench::measure("runlist", threads, opt.iterations, opt.runs, [&](size_t) {
+    auto s = std::make_shared<state>();
+    s->runlist = xrt::runlist{hwctx};
+    s->runs.reserve(opt.runs);
+    for (size_t i = 0; i < opt.runs; ++i) {
+      s->runs.emplace_back(hwctx, kernel, opt.bytes);
+      s->runlist.add(s->runs.back().run);
+    }
+    return [s] {
+      s->runlist.execute();
+      s->runlist.wait();
+    };
+  });
+}
+
+// batch - submit a batch of independent run objects and wait for each
+static bench::result
+bench_batch(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  struct state
+  {
+    std::vector<kernel_run> kruns;
+    std::vector<xrt::run> runs;
+  };
+
+  return bench::measure("batch", threads, opt.iterations, opt.runs, [&](size_t) {
+    auto s = std::make_shared<state>();
+    s->kruns.reserve(opt.runs);
+    for (size_t i = 0; i < opt.runs; ++i) {
+      s->kruns.emplace_back(hwctx, kernel, opt.bytes);
+      s->runs.push_back(s->kruns.back().run);
+    }
+    return [s] {
+      xrt::submit_batch(s->runs);
+      for (auto& run : s->runs)
+        run.wait();
+    };
+  });
+}
+
+// queue - start and wait for a run object through xrt::queue
+static bench::result
+bench_queue(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  struct state
+  {
+    kernel_run kr;
+    xrt::queue queue;
+  };
+
+  return bench::measure("queue", threads, opt.iterations, 1, [&](size_t) {
+    auto s = std::make_shared<state>(state{kernel_run{hwctx, kernel, opt.bytes}, xrt::queue{}});
+    return [s] {
+      auto& run = s->kr.run;
+      s->queue.enqueue([&run] { run.start(); run.wait(); }).wait();
+    };
+  });
+}
+
+// sync - sync a buffer to and from device
+static bench::result
+bench_sync(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  return bench::measure("sync", threads, opt.iterations, 2, [&](size_t) {
+    auto bo = std::make_shared<xrt::bo>(hwctx, opt.bytes, kernel.group_id(0));
+    return [bo] {
+      bo->sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      bo->sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+    };
+  });
+}
+
+// sync_many - sync all sub-buffer slices of a buffer with one call
+static bench::result
+bench_sync_many(const xrt::hw_context& hwctx, const xrt::kernel& kernel, size_t threads, const options& opt)
+{
+  return bench::measure("sync_many", threads, opt.iterations, opt.runs, [&](size_t) {
+    xrt::bo bo(hwctx, opt.bytes * opt.runs, kernel.group_id(0));
+    auto ranges = std::make_shared<std::vector<xrt::bo_sync_range>>();
+    for (size_t slice = 0; slice < opt.runs; ++slice)
+      ranges->push_back({xrt::bo{bo, opt.bytes, slice * opt.bytes}, XCL_BO_SYNC_BO_TO_DEVICE, opt.bytes, 0});
+    return [ranges] {
+      xrt::sync_many(*ranges);
+    };
+  });
+}
+
+// runner - execute and wait for a recipe with two kernel runs
+static bench::result
+bench_runner(const xrt::device& device, const std::vector<char>& xclbin, size_t threads, const options& opt)
+{
+  auto size = std::to_string(opt.bytes);
+  auto recipe = std::string{R"({
+  "header": { "xclbin": "bench.xclbin" },
+  "resources": {
+    "buffers": [
+      { "name": "ifm", "type": "internal", "size": )"} + size + R"( },
+      { "name": "tmp", "type": "internal", "size": )" + size + R"( },
+      { "name": "ofm", "type": "internal", "size": )" + size + R"( }
+    ],
+    "kernels": [ { "name": "k", "instance": ")" + bench::kernel_name + R"(" } ]
+  },
+  "execution": {
+    "runs": [
+      { "name": "k",
+        "arguments": [ { "name": "ifm", "argidx": 0 }, { "name": "tmp", "argidx": 1 } ],
+        "constants": [ { "value": 0, "type": "int", "argidx": 2 } ] },
+      { "name": "k",
+        "arguments": [ { "name": "tmp", "argidx": 0 }, { "name": "ofm", "argidx": 1 } ],
+        "constants": [ { "value": 0, "type": "int", "argidx": 2 } ] }
+    ]
+  }
+})";
+
+  xrt_core::runner::artifacts_repository repo{{"bench.xclbin", xclbin}};
+  return bench::measure("runner", threads, opt.iterations, 2, [&](size_t) {
+    auto runner = std::make_shared<xrt_core::runner>(device, recipe, repo);
+    return [runner] {
+      runner->execute();
+      runner->wait();
+    };
+  });
+}
+
+static void
+run(int argc, char* argv[])
+{
+  std::vector<std::string> args(argv+1,argv+argc);
+  std::string cur;
+  options opt;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return;
+    }
+
+    if (arg == "-c") {
+      opt.csv = true;
+      continue;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-b")
+      opt.benchmarks.insert(arg);
+    else if (cur == "-t")
+      opt.threads = bench::parse_threads(arg);
+    else if (cur == "-i")
+      opt.iterations = std::stoul(arg);
+    else if (cur == "-r")
+      opt.runs = std::stoul(arg);
+    else if (cur == "-s")
+      opt.bytes = std::stoul(arg);
+    else if (cur == "-d")
+      opt.device_index = std::stoi(arg);
+    else
+      throw std::runtime_error("Unknown option value " + cur + " " + arg);
+  }
+
+  if (!std::getenv("XCL_EMULATION_MODE"))
+    std::cout << "Warning: XCL_EMULATION_MODE is not set, measuring with device\n";
+
+  // One CU per thread for the largest thread count, so that threads
+  // are not serialized on CU scheduling
+  auto max_threads = *std::max_element(opt.threads.begin(), opt.threads.end());
+  auto data = bench::create_xclbin(max_threads);
+  xrt::device device{opt.device_index};
+  xrt::xclbin xclbin{data};
+  xrt::hw_context hwctx{device, device.register_xclbin(xclbin)};
+  xrt::kernel kernel{hwctx, bench::kernel_name};
+
+  using bench_fn = bench::result (*)(const xrt::hw_context&, const xrt::kernel&, size_t, const options&);
+  const std::vector<std::pair<std::string, bench_fn>> benchmarks = {
+    {"run", bench_run},
+    {"relaunch", bench_relaunch},
+    {"set_arg", bench_set_arg},
+    {"runlist", bench_runlist},
+    {"batch", bench_batch},
+    {"queue", bench_queue},
+    {"sync", bench_sync},
+    {"sync_many", bench_sync_many},
+  };
+
+  bench::print_header(opt.csv);
+  for (const auto& [name, fn] : benchmarks) {
+    if (!opt.selected(name))
+      continue;
+    for (auto threads : opt.threads)
+      bench::print(fn(hwctx, kernel, threads, opt), opt.csv);
+  }
+
+  if (opt.selected("runner"))
+    for (auto threads : opt.threads)
+      bench::print(bench_runner(device, data, threads, opt), opt.csv);
+
+  // Breakdown of most recent commands with xrt.ini Runtime.command_trace=true
+  if (xrt_core::command_trace::enabled())
+    std::cout << "\ncommand trace\n" << xrt_core::command_trace::summary(xrt_core::command_trace::get_records());
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    run(argc, argv);
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "Exception caught: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "Unknown exception\n";
+  }
+  return 1;
+}